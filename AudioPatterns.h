@@ -26,9 +26,20 @@
 #pragma once
 
 
+#include "frameBuffer.h"
+
+#include "canvas.h"
+Canvas canvas;
+
+#include "rings.h"
+#include "polar.h"
+
 #include "Effects.h"
 Effects effects;
 
+#include "symmetry.h"
+Symmetry symmetry;
+
 #include "fastMath.h"
 #include "Vector.h"
 #include "Boid.h"
@@ -52,7 +63,7 @@ uint8_t lastPattern = 255;      // saves value of the last pattern used
 rgb24 rectColor = WHITE;        // color for static rect pattern, default is white
 
 // star pattern
-#include "star.h"
+#include "Star.h"
 Star stars[NUM_STARS];
 
 
@@ -144,6 +155,138 @@ String patternName[numPatterns] = {
 };
 
 
+// target frame time in mS for each pattern, used by
+// frameScheduler.h instead of delays inside the patterns
+const uint8_t patternFrameMs[numPatterns] = {
+  0,                  // off
+  0,                  // rects
+  0,                  // analyzer7
+  0,                  // analyzer16
+  0,                  // analyzerRaindrop
+  5,                  // starBurst
+  10,                 // bounce
+  20,                 // stars1
+  20,                 // stars2
+  0,                  // spiro
+  10,                 // plasma1
+  20,                 // plasma2
+  0,                  // analyzerUpRight
+  0,                  // lineChart
+  0,                  // kaleido1
+  0,                  // kaleido2
+  0,                  // kaleido3
+  0,                  // radialPixels
+  0,                  // fallingSpectro
+  100,                // linesToOutside
+  0,                  // sineWave
+  0,                  // spiral
+  0,                  // incrementalDrift
+  0,                  // radialTest
+#ifdef INCLUDE_LIFE
+  20                  // life
+#endif
+};
+
+
+// render size for each pattern, 0 = full, 1 = 1/2, 2 = 1/4
+// (see canvas.h). Only the smooth noise patterns are scaled down
+const uint8_t patternRenderShift[numPatterns] = {
+  0,                  // off
+  0,                  // rects
+  0,                  // analyzer7
+  0,                  // analyzer16
+  0,                  // analyzerRaindrop
+  0,                  // starBurst
+  0,                  // bounce
+  0,                  // stars1
+  0,                  // stars2
+  0,                  // spiro
+  1,                  // plasma1
+  1,                  // plasma2
+  0,                  // analyzerUpRight
+  0,                  // lineChart
+  0,                  // kaleido1
+  0,                  // kaleido2
+  0,                  // kaleido3
+  0,                  // radialPixels
+  0,                  // fallingSpectro
+  0,                  // linesToOutside
+  0,                  // sineWave
+  0,                  // spiral
+  0,                  // incrementalDrift
+  0,                  // radialTest
+#ifdef INCLUDE_LIFE
+  0                   // life
+#endif
+};
+
+
+// patterns that scroll down a row each frame, the canvas keeps
+// them in a ring of rows instead of moving the pixels (canvas.h)
+const bool patternScrolls[numPatterns] = {
+  false,              // off
+  false,              // rects
+  false,              // analyzer7
+  false,              // analyzer16
+  false,              // analyzerRaindrop
+  false,              // starBurst
+  false,              // bounce
+  false,              // stars1
+  true,               // stars2
+  false,              // spiro
+  false,              // plasma1
+  false,              // plasma2
+  false,              // analyzerUpRight
+  false,              // lineChart
+  false,              // kaleido1
+  false,              // kaleido2
+  false,              // kaleido3
+  false,              // radialPixels
+  true,               // fallingSpectro
+  false,              // linesToOutside
+  false,              // sineWave
+  false,              // spiral
+  false,              // incrementalDrift
+  false,              // radialTest
+#ifdef INCLUDE_LIFE
+  false               // life
+#endif
+};
+
+
+// kaleidoscope symmetry, the pattern only draws the wedge and
+// the rest is filled in by symmetry.apply() (symmetry.h)
+const uint8_t patternSymmetry[numPatterns] = {
+  SYMMETRY_NONE,      // off
+  SYMMETRY_NONE,      // rects
+  SYMMETRY_NONE,      // analyzer7
+  SYMMETRY_NONE,      // analyzer16
+  SYMMETRY_NONE,      // analyzerRaindrop
+  SYMMETRY_NONE,      // starBurst
+  SYMMETRY_NONE,      // bounce
+  SYMMETRY_NONE,      // stars1
+  SYMMETRY_NONE,      // stars2
+  SYMMETRY_NONE,      // spiro
+  SYMMETRY_NONE,      // plasma1
+  SYMMETRY_NONE,      // plasma2
+  SYMMETRY_NONE,      // analyzerUpRight
+  SYMMETRY_NONE,      // lineChart
+  SYMMETRY_MIRROR4,   // kaleido1
+  SYMMETRY_MIRROR4,   // kaleido2
+  SYMMETRY_MIRROR8,   // kaleido3
+  SYMMETRY_NONE,      // radialPixels
+  SYMMETRY_NONE,      // fallingSpectro
+  SYMMETRY_NONE,      // linesToOutside
+  SYMMETRY_NONE,      // sineWave
+  SYMMETRY_NONE,      // spiral
+  SYMMETRY_NONE,      // incrementalDrift
+  SYMMETRY_NONE,      // radialTest
+#ifdef INCLUDE_LIFE
+  SYMMETRY_NONE       // life
+#endif
+};
+
+
 
 //--------------------------------------------------------------------------------
 
@@ -158,11 +301,6 @@ class AudioPatterns {
     uint16_t lastY = 0;             // general purpose var
     uint32_t counts = 0;            // general purpose counter
 
-    // scaling tools
-    uint16_t Y_AUDIO_SF;
-    uint16_t X_PIXELS_PER_BAND7;
-    uint16_t X_PIXELS_PER_BAND16;
-
     // spiro pattern
     uint8_t theta1 = 0;              // angle used in several patterns
     uint8_t theta2 = 0;              // angle used in several patterns
@@ -175,6 +313,11 @@ class AudioPatterns {
     boolean spiroIncrement = false;
     boolean handledChange = false;
 
+    // frameSteps() remainders
+    uint32_t thetaCarry = 0;
+    uint32_t hueCarry = 0;
+    int32_t noiseXCarry = 0;
+
     // boids pattern
     PVector gravity;                // boid vars
     PVector impulse;                // boid vars
@@ -202,38 +345,59 @@ class AudioPatterns {
       Serial.print(" = ");
       Serial.println(patternName[pattern]);
 
-      X_PIXELS_PER_BAND7 = matrix.getScreenWidth() / EQ_BANDS7;
-      X_PIXELS_PER_BAND16 = matrix.getScreenWidth() / EQ_BANDS16;
-      Y_AUDIO_SF = (MAX_AUDIO + 1) / (matrix.getScreenHeight() + 1);
+      resetQuality();
+      canvas.setRenderScale(patternRenderShift[pattern]);
+      canvas.setScrolling(patternScrolls[pattern]);
+      symmetry.build(canvas.width(), canvas.height(), patternSymmetry[pattern]);
+
+      // ring tables for the radial patterns, freed for the others
+      if (pattern == RADIALTEST)
+        streamRings.prepare(kMatrixCenterX);
+      else if (pattern == INCREMENTALDRIFT)
+        streamRings.prepare(16);
+      else
+        streamRings.release();
+
+      if (pattern == RADIALPIXELS)
+        radialRings.prepare(13);
+      else
+        radialRings.release();
+
+      // the polar map is only kept while a pattern uses it, it's
+      // built again the first time it's read
+      if (!usesPolarMap())
+        polar.release();
+
+      // every pattern keeps the lit tiles up to date, the Effects
+      // passes and symmetry.apply() included
+      canvas.trackTiles(true);
+      setAudioScreenHeight(matrix.getScreenHeight());
+      buildBandMaps(matrix.getScreenWidth());
     }
 
 
-    void update()
+    // linesToOutside, and starBurst coloring by distance
+    bool usesPolarMap()
     {
-      // get audio data
-      readAudio();
-
-      // dim display if no audio
-      if (gain == maxGain)
-      {
-        sleepCount++;
+      return pattern == LINESTOOUTSIDE || (pattern == STARBURST && colorMode == 3);
+    }
 
-        if (brightness > 0 && sleepCount > 4000)
-          brightness -= 1;
-      }
-      else
-      {
-        sleepCount = 0;
-        if (brightness < 255)
-          brightness += 1;
-      }
 
+    void update()
+    {
+      // one time step for the whole frame
+      tickFrameClock();
+      palette.update();
 
       // periodically check if its time to increment pattern
-      // but don't switch while sleeping
+      // but don't switch while sleeping. Once it's time, wait for
+      // a downbeat (from the last frame) if there's a tempo
       if (autoincrement && brightness > 64)
       {
-        if (millis() - lastSwitch > AUTO_SWITCH_DURATION)
+        uint32_t sinceSwitch = millis() - lastSwitch;
+
+        if (sinceSwitch > AUTO_SWITCH_DURATION &&
+            (downbeat || bpm == 0 || sinceSwitch > AUTO_SWITCH_DURATION + AUTO_SWITCH_GRACE))
         {
           pattern++;
           if (pattern > numPatterns - 1)
@@ -257,8 +421,29 @@ class AudioPatterns {
         init();
       }
 
+      // get audio data as late as possible so the pattern
+      // draws with the newest bands from the sampler
+      readAudio();
+
+      // dim display if no audio
+      if (gain == maxGain)
+      {
+        sleepCount++;
+
+        if (brightness > 0 && sleepCount > 4000)
+          brightness -= 1;
+      }
+      else
+      {
+        sleepCount = 0;
+        if (brightness < 255)
+          brightness += 1;
+      }
+
       // update buffers before updating pattern
-      rgb24Buffer = backgroundLayer.backBuffer();
+      rgb24Buffer = canvas.buffer();
+      fb.attach(rgb24Buffer, canvas.renderShift(), canvas.scrollTop());
+      canvas.beginFrame();
 
       // draw audio pattern
       switch (pattern)
@@ -300,30 +485,23 @@ class AudioPatterns {
       // remember the pattern
       lastPattern = pattern;
 
-      // special cases for now, updated in pattern
-      if (pattern == STARBURST)
-        return;
-
-#ifdef INCLUDE_LIFE
-      if (pattern == LIFE)
-        return;
-#endif
-
       // update brightness
       matrix.setBrightness(brightness);
 
-      // swap in new screen
-      backgroundLayer.swapBuffers();
+      // the only place a frame is presented, patterns keep
+      // building on the last frame (see canvas.h)
+      canvas.present();
 
       // get updated screen buffer
-      rgb24Buffer = backgroundLayer.backBuffer();
+      rgb24Buffer = canvas.buffer();
+      fb.attach(rgb24Buffer, canvas.renderShift(), canvas.scrollTop());
     }
 
 
     void off()
     {
       if (!initialized)
-        backgroundLayer.fillScreen(BLACK);
+        canvas.fillScreen(BLACK);
 
       initialized = true;
     }
@@ -335,7 +513,7 @@ class AudioPatterns {
     {
       if (!initialized)
       {
-        backgroundLayer.fillScreen(BLACK);
+        canvas.fillScreen(BLACK);
         initialized = true;
 
         rgb24 color = rectColor;
@@ -348,7 +526,7 @@ class AudioPatterns {
           uint16_t vOffset2 = i * 2;
           uint16_t hOffset2 = i * 2;
 
-          backgroundLayer.drawRectangle(i + hOffset1, i + vOffset1, (kScreenWidth - 1) - hOffset2, kScreenHeight - vOffset2, color);
+          canvas.drawRectangle(i + hOffset1, i + vOffset1, (kScreenWidth - 1) - hOffset2, kScreenHeight - vOffset2, color);
 
           intensity = intensity * 0.95;
           color = rgb24SetColorBrightness(color, (uint8_t )intensity);
@@ -364,20 +542,33 @@ class AudioPatterns {
     void analyzer7()
     {
       initialized = true;
-      backgroundLayer.fillScreen(BLACK);
+      canvas.fillScreen(BLACK);
 
-      for (int x = 0; x < kScreenWidth; x++)
+#ifdef USE_FFT_AUDIO
+      if (fftActive() && !testMode)
       {
-        int band = x / X_PIXELS_PER_BAND7;
-        int level = peaks[band] / Y_AUDIO_SF;
+        fftColumns(bandMap7, rgb24Colors8, 2);
+        return;
+      }
+#endif
+
+      // the columns of a band are side by side with the same
+      // height, so each band is one bar. The map covers every
+      // column, the last one included
+      for (int x = 0; x < bandMap7.width; )
+      {
+        int band = bandMap7.band[x];
+        int level = bandMap7.height[x];
         if (level > kScreenHeight)
           level = kScreenHeight;
 
         // show unscaled levels for audio input testing
         if (testMode)
-          level = rawAudio[band] / Y_AUDIO_SF;
+          level = rawAudio[band] / yAudioSF;
 
-        backgroundLayer.drawLine(x, kScreenHeight, x, kScreenHeight - level - level, rgb24Colors8[band]);
+        int last = bandEnd(bandMap7, x);
+        canvas.fillRectangle(x, kScreenHeight - level - level, last, kScreenHeight, rgb24Colors8[band]);
+        x = last + 1;
       }
     }
 
@@ -386,51 +577,79 @@ class AudioPatterns {
     void analyzer16()
     {
       initialized = true;
-      backgroundLayer.fillScreen(BLACK);
+      canvas.fillScreen(BLACK);
 
-      for (int x = 0; x < kScreenWidth; x++)
+#ifdef USE_FFT_AUDIO
+      if (fftActive())
       {
-        int band = x / X_PIXELS_PER_BAND16;
-        if (band < EQ_BANDS16)
-        {
-          int level = audio16[band] / Y_AUDIO_SF;
-          backgroundLayer.drawLine(x, kScreenHeight, x, kScreenHeight - level, rgb24Colors16[band]);
-        }
+        fftColumns(bandMap16, rgb24Colors16, 1);
+        return;
+      }
+#endif
+
+      for (int x = 0; x < bandMap16.width; )
+      {
+        int level = bandMap16.height[x];
+        int last = bandEnd(bandMap16, x);
+        canvas.fillRectangle(x, kScreenHeight - level, last, kScreenHeight, rgb24Colors16[bandMap16.band[x]]);
+        x = last + 1;
+      }
+    }
+
+
+#ifdef USE_FFT_AUDIO
+    // a column each from the fft bands, in the color of the bar
+    // of colorMap it's in, heights x scale like the bars
+    void fftColumns(BandMap& colorMap, const rgb24* colors, uint8_t scale)
+    {
+      for (int x = 0; x < fftColumnMap.width; x++)
+      {
+        int level = min(fftColumnMap.height[x], kScreenHeight);
+        canvas.drawVLine(x, kScreenHeight - level * scale, kScreenHeight, colors[colorMap.band[x]]);
       }
     }
+#endif
+
+
+    // last column of the band that starts at x
+    int bandEnd(BandMap& map, int x)
+    {
+      uint8_t band = map.band[x];
+      while (x + 1 < map.width && map.band[x + 1] == band)
+        x++;
+      return x;
+    }
 
 
 
     void analyzerRaindrop()
     {
-      uint16_t x = 0;
       initialized = true;
 
       rgb24DimAll(240);
 
-      for (uint16_t index = 0; index < EQ_BANDS16; index++)
+      // a drop in the first column of each band
+      for (uint16_t x = 0; x < bandMap16.width; x = bandEnd(bandMap16, x) + 1)
       {
-        // calc x-axis position
-        x = index * X_PIXELS_PER_BAND16;
-
-        // scale to prevent clipping
-        int16_t level = audio16[index] / (Y_AUDIO_SF + 2); // smaller divisor = more activity
+        uint8_t index = bandMap16.band[x];
 
-        backgroundLayer.drawLine(x, kScreenHeight - level - 1, x, kScreenHeight, rgb24Colors16[index]);
+        // 3/4 of the bar height to prevent clipping
+        int16_t level = (bandMap16.height[x] * 3) >> 2;
 
-        //  subtract the height of the length (number of leds) of the raindrop
-        // and then draw over the line with a black line
-        level -= 5;
-        if (level < 0)
-          level = 0;
+        // the raindrop is the top 5 leds of the bar, the rest of it
+        // down to the bottom row is black
+        int16_t gap = max(level - 5, 0);
 
-        backgroundLayer.drawLine(x, kScreenHeight - 1 - level, x, kScreenHeight - 1, BLACK);
+        if (level > 0)
+          canvas.drawVLine(x, kScreenHeight - level - 1, kScreenHeight - 2 - gap, rgb24Colors16[index]);
+        canvas.drawVLine(x, kScreenHeight - 1 - gap, kScreenHeight - 1, BLACK);
+        canvas.drawPixel(x, kScreenHeight, rgb24Colors16[index]);
 
         // add bottom row of always on leds to create a mirror-like effect
         if (audio16[index] > 0)
-          backgroundLayer.drawPixel(x, kScreenHeight - 1, rgb24Colors16[index]);
+          canvas.drawPixel(x, kScreenHeight - 1, rgb24Colors16[index]);
         else
-          backgroundLayer.drawPixel(x, kScreenHeight - 1, BLACK);
+          canvas.drawPixel(x, kScreenHeight - 1, BLACK);
       }
     }
 
@@ -449,8 +668,9 @@ class AudioPatterns {
         initialized = true;
       }
 
-      // process starfield
-      for (uint16_t i =  0; i < NUM_STARS; i++)
+      // process starfield, fewer stars when running behind
+      uint16_t numStars = qualityScale(NUM_STARS, NUM_STARS / 4);
+      for (uint16_t i =  0; i < numStars; i++)
       {
         // move star if alive
         if (stars[i].isAlive())
@@ -461,11 +681,6 @@ class AudioPatterns {
 
       // dim all stars to create trails
       rgb24DimAll(persistance);
-
-      // refresh the led matrix
-      backgroundLayer.swapBuffers();
-
-      delay(5);
     }
 
 
@@ -474,21 +689,21 @@ class AudioPatterns {
     {
       if (!initialized)
       {
-        backgroundLayer.fillScreen(BLACK);
+        canvas.fillScreen(BLACK);
         initialized = true;
 
       }
 
       rgb24DimAll(250);
 
-      if (maxLevel > 200)
+      // extra stars on each onset so the bursts follow the music
+      if (maxLevel > 200 || onset)
       {
         rgb24 color = rgb24Colors8[maxBand];
+        uint8_t count = onset ? 16 : 8;
 
-        for (uint8_t i = 0; i < 8; i++)
-          backgroundLayer.drawPixel(random(0, kScreenWidth), random(0, kScreenHeight), color);
-
-        delay(20);
+        for (uint8_t i = 0; i < count; i++)
+          canvas.drawPixel(random(0, kScreenWidth), random(0, kScreenHeight), color);
       }
     }
 
@@ -498,7 +713,7 @@ class AudioPatterns {
     {
       if (!initialized)
       {
-        backgroundLayer.fillScreen(BLACK);
+        canvas.fillScreen(BLACK);
         initialized = true;
       }
 
@@ -507,7 +722,7 @@ class AudioPatterns {
       // add some smear - dosen't work after rotation mode
       //effects.StreamRight(120);
       //doing this instead
-      effects.MoveDown();
+      canvas.scrollDown();
       rgb24DimAll(250);
 
 
@@ -517,10 +732,8 @@ class AudioPatterns {
         rgb24 color = rgb24Colors8[maxBand];
 
         for (uint8_t i = 0; i < 8; i++)
-          backgroundLayer.drawPixel(random(0, kScreenWidth), random(0, kScreenHeight), color);
+          canvas.drawPixel(random(0, kScreenWidth), random(0, kScreenHeight), color);
       }
-
-      delay(20);
     }
 
 
@@ -569,8 +782,8 @@ class AudioPatterns {
         boid.location.x = i;
         boid.applyForce(gravity * 2);
 
-        uint16_t bandIndex = i / X_PIXELS_PER_BAND16;
-        float level = audio16[bandIndex];
+        uint8_t bandIndex = bandMap16.band[i];
+        float level = columnMap.level[i];
 
         if (boid.location.y == height - 1)
         {
@@ -582,12 +795,8 @@ class AudioPatterns {
         boid.bounceOffBorders(0.2);
         boids[i] = boid;
 
-        backgroundLayer.drawPixel(boid.location.x, boid.location.y + offset, rgb24Colors16[bandIndex]);
-        delayMicroseconds(30);
+        canvas.drawPixel(boid.location.x, boid.location.y + offset, rgb24Colors16[bandIndex]);
       }
-
-      // pattern speed delay
-      delay(5);
     }
 
 
@@ -604,6 +813,14 @@ class AudioPatterns {
       rgb24DimAll(251);
       boolean change = false;
 
+      // the quality level can drop the limit while there are more
+      uint8_t maxSpiros = qualityScale(32, 4);
+      if (spiroCount > maxSpiros)
+      {
+        spiroCount = maxSpiros;
+        spiroOffset = 256 / spiroCount;
+      }
+
       minR = kMatrixCenterY - radius;
       maxR = kMatrixCenterY + radius + 1;
 
@@ -615,7 +832,7 @@ class AudioPatterns {
         uint8_t x2 = mapsin8(theta2 + i * spiroOffset, x - radius, x + radius);
         uint8_t y2 = mapcos8(theta2 + i * spiroOffset, y - radius, y + radius);
 
-        backgroundLayer.drawPixel(x2, y2, rgb24Colors8[pkBand]);
+        canvas.drawPixel(x2, y2, rgb24Colors8[pkBand]);
 
         // check if spiros are in center
         if ((x2 == kMatrixCenterX     && y2 == kMatrixCenterY) ||
@@ -650,8 +867,8 @@ class AudioPatterns {
           if (spiroCount < 4 && pkLevel > 300)
             spiroCount += 1;
 
-          else if (spiroCount < 32 && pkBand > 2 && pkLevel > 300)
-            spiroCount *= 2;
+          else if (spiroCount < maxSpiros && pkBand > 2 && pkLevel > 300)
+            spiroCount = min(spiroCount * 2, (int)maxSpiros);
 
           else if (spiroCount > 1 && pkBand < 3)
           {
@@ -682,24 +899,23 @@ class AudioPatterns {
 
       // x scrolling through
       // = horizontal movement
-      effects.noiseX = effects.noiseX + 50;
+      effects.noiseX = effects.noiseX + frameSteps(5000, noiseXCarry);
 
       // y controlled by lowest band
       // = jumping of the pattern
       effects.noiseY = peaks[0] / 8;
 
-      // calculate the noise array
-      effects.FillNoiseCentral(scale);
+      // calculate the noise array, only the pixels that get drawn
+      uint8_t shift = canvas.renderShift();
+      effects.FillNoiseCentral(scale, max(qualityStep(), (uint8_t)(1 << shift)));
 
-      for (uint16_t i = 0; i < kScreenWidth; i++)
+      for (uint16_t j = 0; j < kScreenHeight >> shift; j++)
       {
-        for (uint16_t j = 0; j < kScreenHeight; j++)
-        {
-          uint8_t pos = effects.noise[i][j];
-          backgroundLayer.drawPixel(i, j, wheel8(pos));
-        }
+        rgb24* row = fb.row(j);
+        for (uint16_t i = 0; i < kScreenWidth >> shift; i++)
+          row[i] = palette.color(effects.noise[i << shift][j << shift]);
       }
-      delay(10);
+      canvas.markAll();
     }
 
 
@@ -721,24 +937,23 @@ class AudioPatterns {
 
       // x scrolling through
       // = horizontal movement
-      effects.noiseX = effects.noiseX - 20 + avgLevel / 8;
+      effects.noiseX = effects.noiseX + frameSteps((int32_t)(avgLevel / 8 - 20) * 100, noiseXCarry);
 
       // = jumping of the pattern
       effects.noiseY = level5 / 2;
 
-      // calculate the noise array
-      effects.FillNoiseCentral(scale);
+      // calculate the noise array, only the pixels that get drawn
+      uint8_t shift = canvas.renderShift();
+      effects.FillNoiseCentral(scale, max(qualityStep(), (uint8_t)(1 << shift)));
 
       // map the noise
-      for (uint16_t i = 0; i < kScreenWidth; i++)
+      for (uint16_t j = 0; j < kScreenHeight >> shift; j++)
       {
-        for (uint16_t j = 0; j < kScreenHeight; j++)
-        {
-          uint8_t c = effects.noise[i][j] * 3 / 2;
-          backgroundLayer.drawPixel(i, j, wheel8(c));
-        }
+        rgb24* row = fb.row(j);
+        for (uint16_t i = 0; i < kScreenWidth >> shift; i++)
+          row[i] = palette.color(effects.noise[i << shift][j << shift] * 3 / 2);
       }
-      delay(20);
+      canvas.markAll();
     }
 
 
@@ -748,10 +963,9 @@ class AudioPatterns {
     {
       for (uint16_t x = 0; x < width; x++)
       {
-        uint8_t band = x / X_PIXELS_PER_BAND16;
-        uint16_t level = audio16[band] / Y_AUDIO_SF;
+        uint16_t level = columnMap.height[x];
         uint16_t y = height - 1 - level;
-        backgroundLayer.drawPixel(x, y, rgb24Colors16[band]);
+        canvas.drawPixel(x, y, rgb24Colors16[bandMap16.band[x]]);
       }
     }
 
@@ -774,8 +988,8 @@ class AudioPatterns {
       {
         rgb24 color = rgb24Colors16[i + 1];
 
-        uint16_t level = audio16[i] / Y_AUDIO_SF;
-        uint16_t nextLevel = audio16[i + 1] / Y_AUDIO_SF;
+        uint16_t level = audioHeight16[i];
+        uint16_t nextLevel = audioHeight16[i + 1];
 
         uint16_t y = kScreenHeight - 1 - level;
         uint16_t nextY = kScreenHeight - 1 - nextLevel;
@@ -784,7 +998,7 @@ class AudioPatterns {
         //nextY = nextY >= MATRIX_HEIGHT ? MATRIX_HEIGHT - 1 : nextY;
         uint16_t length = kScreenWidth / 16;
 
-        backgroundLayer.drawLine(i * length,  y, (i * length) + length,  nextY, color);
+        canvas.drawLine(i * length,  y, (i * length) + length,  nextY, color);
       }
     }
 
@@ -793,20 +1007,30 @@ class AudioPatterns {
     void lineChart()
     {
       initialized = true;
-      backgroundLayer.fillScreen(BLACK);
+      canvas.fillScreen(BLACK);
       drawAnalyzerLines();
     }
 
 
 
 
+    // the kaleidoscope seeds were placed for a 32x32 quarter,
+    // spread them over the quarter of this screen
+    void drawSeed(uint16_t x, uint16_t y, const rgb24& color)
+    {
+      uint16_t quarter = min(canvas.width(), canvas.height()) / 2;
+      symmetry.drawPixel(x * quarter / 32, y * quarter / 32, color);
+    }
+
+
+
     void kaleido1()
     {
       uint8_t index;
 
       if (!initialized)
       {
-        backgroundLayer.fillScreen(BLACK);
+        canvas.fillScreen(BLACK);
         initialized = true;
       }
 
@@ -814,34 +1038,33 @@ class AudioPatterns {
       {
         index = hueOffset % 8;
         //printValue("index1", index);
-        backgroundLayer.drawPixel(1, 1, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(5, 5, rgb24Colors8[index]);
+        drawSeed(1, 1, rgb24Colors8[index]);
+        drawSeed(5, 5, rgb24Colors8[index]);
       }
 
       if (audio[3] > 400)
       {
         index = (hueOffset + 85) % 8;
         //printValue("index2", index);
-        backgroundLayer.drawPixel(10, 10, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(16, 16, rgb24Colors8[index]);
+        drawSeed(10, 10, rgb24Colors8[index]);
+        drawSeed(16, 16, rgb24Colors8[index]);
       }
 
       if (audio[5] > 400)
       {
         index = (hueOffset + 170) % 8;
         //printValue("index3", index);
-        backgroundLayer.drawPixel(20, 20, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(28, 28, rgb24Colors8[index]);
+        drawSeed(20, 20, rgb24Colors8[index]);
+        drawSeed(28, 28, rgb24Colors8[index]);
       }
 
       effects.updateBuffer();
 
-      effects.SpiralStream(32, 32, 32, 128);
-      effects.Caleidoscope1();
-      effects.mirrorDown(0, 0, 0, 32);
-      effects.mirrorDown(0, 0, 64, 64);
-      effects.mirrorLeft(0, 0, 64, 128);
-      effects.mirrorLeft(0, 0, 64, 128);
+      // swirl the top left quarter, then mirror it
+      uint16_t centerX = canvas.width() / 2;
+      uint16_t centerY = canvas.height() / 2;
+      effects.SpiralStreamQuarter(centerX, centerY, min(centerX, centerY), 128);
+      symmetry.apply();
 
       EVERY_N_MILLIS(100)
       {
@@ -858,7 +1081,7 @@ class AudioPatterns {
 
       if (!initialized)
       {
-        backgroundLayer.fillScreen(BLACK);
+        canvas.fillScreen(BLACK);
         initialized = true;
       }
 
@@ -866,19 +1089,19 @@ class AudioPatterns {
       {
         index = hueOffset % 8;
         //printValue("index1", index);
-        backgroundLayer.drawPixel(1, 1, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(3, 7, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(7, 13, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(12, 18, rgb24Colors8[index]);
+        drawSeed(1, 1, rgb24Colors8[index]);
+        drawSeed(3, 7, rgb24Colors8[index]);
+        drawSeed(7, 13, rgb24Colors8[index]);
+        drawSeed(12, 18, rgb24Colors8[index]);
       }
 
       if (audio[3] > 400)
       {
         index = (hueOffset + 85) % 8;
         //printValue("index2", index);
-        backgroundLayer.drawPixel(8, 10, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(10, 16, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(20, 16, rgb24Colors8[index]);
+        drawSeed(8, 10, rgb24Colors8[index]);
+        drawSeed(10, 16, rgb24Colors8[index]);
+        drawSeed(20, 16, rgb24Colors8[index]);
 
       }
 
@@ -886,20 +1109,19 @@ class AudioPatterns {
       {
         index = (hueOffset + 170) % 8;
         //printValue("index3", index);
-        backgroundLayer.drawPixel(10, 3, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(20, 20, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(28, 22, rgb24Colors8[index]);
-        backgroundLayer.drawPixel(28, 12, rgb24Colors8[index]);
+        drawSeed(10, 3, rgb24Colors8[index]);
+        drawSeed(20, 20, rgb24Colors8[index]);
+        drawSeed(28, 22, rgb24Colors8[index]);
+        drawSeed(28, 12, rgb24Colors8[index]);
       }
 
       effects.updateBuffer();
 
-      effects.SpiralStream(32, 32, 32, 128);
-      effects.Caleidoscope1();
-      effects.mirrorDown(0, 0, 0, 32);
-      effects.mirrorDown(0, 0, 64, 64);
-      effects.mirrorLeft(0, 0, 64, 128);
-      effects.mirrorLeft(0, 0, 64, 128);
+      // swirl the top left quarter, then mirror it
+      uint16_t centerX = canvas.width() / 2;
+      uint16_t centerY = canvas.height() / 2;
+      effects.SpiralStreamQuarter(centerX, centerY, min(centerX, centerY), 128);
+      symmetry.apply();
 
       EVERY_N_MILLIS(100)
       {
@@ -941,19 +1163,14 @@ class AudioPatterns {
         //}
 
         // pixel(x, y, color)
-        backgroundLayer.drawPixel(x1, y, rgb24Colors16[color]);
-        backgroundLayer.drawPixel(x2, y, rgb24Colors16[color]);
-        backgroundLayer.drawPixel(x1 + 8, y + 8, rgb24Colors16[color]);
-        backgroundLayer.drawPixel(x2 + 8, y + 8, rgb24Colors16[color]);
+        drawSeed(x1, y, rgb24Colors16[color]);
+        drawSeed(x2, y, rgb24Colors16[color]);
+        drawSeed(x1 + 8, y + 8, rgb24Colors16[color]);
+        drawSeed(x2 + 8, y + 8, rgb24Colors16[color]);
       }
 
       effects.updateBuffer();
-
-      effects.Caleidoscope5();
-      effects.Caleidoscope1();
-      effects.mirrorDown(0, 0, 64, 64);
-      effects.mirrorLeft(0, 0, 64, 64);
-      effects.mirrorLeft(0, 64, 64, 64);
+      symmetry.apply();
       rgb24DimAll(240);
     }
 
@@ -970,6 +1187,9 @@ class AudioPatterns {
 
       rgb24DimAll(230);
 
+      const uint16_t* inner = radialRings.ring(4);
+      const uint16_t* outer = radialRings.ring(12);
+
       for (uint8_t i = 0; i < EQ_BANDS7; i++)
       {
         level = peaks[i];
@@ -979,26 +1199,16 @@ class AudioPatterns {
         if (i == 0 && level > 600)
           theta1 -= 1;
 
-        color = wheel8(level / 4);
+        color = palette.color(level / 4);
         localtheta = theta1 - (i * 2) * (256 / 14);
 
-        uint16_t x = mapcos8(localtheta, 4, kScreenWidth - 1 - 4);
-        uint16_t y = mapsin8(localtheta, 4, kScreenHeight - 1 - 4);
-        rgb24Buffer[XY(x, y)] = color;
-
-        x = mapcos8(localtheta, 12, kScreenWidth - 1 - 12);
-        y = mapsin8(localtheta, 12, kScreenHeight - 1 - 12);
-        rgb24Buffer[XY(x, y)] = color;
+        canvas.setIndex(inner[localtheta], color);
+        canvas.setIndex(outer[localtheta], color);
 
         localtheta = theta1 - (i * 2 + 1) * (256 / 14);
 
-        x = mapcos8(localtheta, 4, kScreenWidth - 1 - 4);
-        y = mapsin8(localtheta, 4, kScreenHeight - 1 - 4);
-        rgb24Buffer[XY(x, y)] = color;
-
-        x = mapcos8(localtheta, 12, kScreenWidth - 1 - 12);
-        y = mapsin8(localtheta, 12, kScreenHeight - 1 - 12);
-        rgb24Buffer[XY(x, y)] = color;
+        canvas.setIndex(inner[localtheta], color);
+        canvas.setIndex(outer[localtheta], color);
       }
     }
 
@@ -1008,22 +1218,23 @@ class AudioPatterns {
     {
       initialized = true;
 
-      effects.updateBuffer();
-      effects.MoveDown();
+      canvas.scrollDown();
+      BandMap& spectrum = spectrumMap();
 
       for (uint16_t x = 0; x < kScreenWidth; x++)
       {
-        uint16_t level = audio16[x * 16 / kScreenWidth] / 4;
+        uint16_t level = spectrum.level[x] / 4;
         level =  constrain(level, 0, 255);
         uint8_t wheelPos = x * 256 / kScreenWidth;
 
         //printValue("level", level);
         //printValue("wheelPos", wheelPos);
 
-        rgb24 color = wheel8(wheelPos);
+        rgb24 color = palette.color(wheelPos);
         color = rgb24SetColorBrightness(color, level);
-        rgb24Buffer[XY(x, 1)] = color;
+        fb.at(x, 1) = color;
       }
+      canvas.markArea(0, 1, kScreenWidth - 1, 1);
     }
 
 
@@ -1036,46 +1247,49 @@ class AudioPatterns {
       rgb24DimAll(235);
       //effects.SpiralStream(15, 15, 16, 120);
 
-      uint16_t x0 = kMatrixCenterX;
-      uint16_t y0 = kMatrixCenterY;
-      uint16_t linesPerBand = 1;
-
-      float degreesPerLine = 360 / (EQ_BANDS7 * linesPerBand);
-      float angle = 360.0;
+      // a wedge for each band out from the center, band 0
+      // starting straight down and going round clockwise
+      uint8_t reach[EQ_BANDS7];
+      rgb24 colors[EQ_BANDS7];
+      uint16_t maxLength = 0;
 
       for (uint8_t band = 0; band < EQ_BANDS7; band++)
       {
         int level = audio[band] / 4;
+        uint16_t length = level / (kMatrixCenterY / 2);
 
-        for (uint16_t i = 0; i < linesPerBand; i++)
-        {
-          rgb24 color = wheel8(level / 4);
-          float length = level / (kMatrixCenterY / 2);
+        colors[band] = palette.color(level / 4);
+        reach[band] = min(polar.radiusOf(length), (uint16_t)255);
+        maxLength = max(maxLength, length);
+      }
 
-          if (length > 0.0)
-          {
-            float radians = radians(angle);
-            uint16_t x1 = x0 + length * sin(radians);
-            uint16_t y1 = y0 + length * cos(radians);
-
-            radians = radians(angle - degreesPerLine);
-            uint16_t x2 = x0 + length * sin(radians);
-            uint16_t y2 = y0 + length * cos(radians);
-
-            // printValue("x0", x0);
-            // printValue("y0", y0);
-            // printValue("x1", x1);
-            // printValue("y1", y1);
-            // printValue("x2", x2);
-            // printValue("y2", y2);
-
-            backgroundLayer.fillTriangle(x0, y0, x1, y1, x2, y2, color);
-          }
+      if (maxLength == 0)
+        return;
+
+      // only the box the longest wedge can reach
+      int16_t x0 = max(kMatrixCenterX - maxLength, 0);
+      int16_t x1 = min(kMatrixCenterX + maxLength, (int)kScreenWidth);
+      int16_t y0 = max(kMatrixCenterY - maxLength, 0);
+      int16_t y1 = min(kMatrixCenterY + maxLength, (int)kScreenHeight);
+
+      for (int16_t y = y0; y <= y1; y++)
+      {
+        const PolarPixel* polarRow = polar.row(y);
+        if (polarRow == nullptr)
+          return;
+
+        rgb24* row = fb.row(y);
 
-          angle -= degreesPerLine;
+        for (int16_t x = x0; x <= x1; x++)
+        {
+          // angle 64 is straight down
+          uint8_t band = (uint8_t)(polarRow[x].angle + 192) * EQ_BANDS7 >> 8;
+          if (polarRow[x].radius < reach[band])
+            row[x] = colors[band];
         }
-        delay(100);
       }
+
+      canvas.markArea(x0, y0, x1, y1);
     }
 
 
@@ -1093,7 +1307,7 @@ class AudioPatterns {
         level = constrain(level, 10, kScreenHeight / 2);
         uint16_t y = beatsin8(x / 2, 0, level);
 
-        backgroundLayer.drawPixel(x, y + kScreenHeight / 4, rgb24Colors8[colorIndex]);
+        canvas.drawPixel(x, y + kScreenHeight / 4, rgb24Colors8[colorIndex]);
       }
     }
 
@@ -1121,7 +1335,7 @@ class AudioPatterns {
           printValue("y", y);
         }
 
-        backgroundLayer.drawPixel(x, y, rgb24Colors8[(uint8_t )avgBand]);
+        canvas.drawPixel(x, y, rgb24Colors8[(uint8_t )avgBand]);
       }
     }
 
@@ -1136,28 +1350,25 @@ class AudioPatterns {
 
       for (uint16_t i = 0; i < kScreenWidth; i++)
       {
-        uint16_t x = 0;
-        uint16_t y = 0;
-
         uint8_t bandIndex = 0;
 
         if (i < 16)
         {
-          x = beatcos8((i + 1) * 2, i, (kScreenWidth - 1 - 1) - i);
-          y = beatsin8((i + 1) * 2, i, (kScreenHeight - 1 - 1) - i);
+          // ring i at its own beat, same as beatcos8 / beatsin8
+          uint8_t theta = beat8((i + 1) * 2);
+          canvas.setIndex(streamRings.ring(i)[theta], rgb24Colors8[maxBand]);
           bandIndex = i / 2;
         }
         else
         {
-          x = beatsin8((kScreenWidth - 1 - i) * 2, (kScreenWidth - 1 - 1) - i, i);
-          y = beatcos8((kScreenWidth - 1 - i) * 2, (kScreenHeight - 1 - 1) - i, i);
+          uint16_t x = beatsin8((kScreenWidth - 1 - i) * 2, (kScreenWidth - 1 - 1) - i, i);
+          uint16_t y = beatcos8((kScreenWidth - 1 - i) * 2, (kScreenHeight - 1 - 1) - i, i);
+          canvas.drawPixel(x, y, rgb24Colors8[maxBand]);
           bandIndex = (31 - i) / 2;
         }
 
         if (bandIndex > EQ_BANDS7)
           bandIndex = EQ_BANDS7;
-
-        backgroundLayer.drawPixel(x, y, rgb24Colors8[maxBand]);
       }
     }
 
@@ -1169,20 +1380,15 @@ class AudioPatterns {
       rgb24DimAll(254);
       initialized = true;
 
+      // theta 2 & hue 1 every 25 mS
+      theta1 += frameSteps(80, thetaCarry);
+      hueOffset += frameSteps(40, hueCarry);
+
       for (uint16_t offset = 0; offset < kMatrixCenterX; offset++)
       {
         uint8_t hue = 255 - (offset * 16 + hueOffset);
-        rgb24 color = wheel8(hue);
-        uint16_t x = mapcos8(theta1, offset, (kScreenWidth - 1 - 1) - offset);
-        uint16_t y = mapsin8(theta1, offset, (kScreenHeight - 1 - 1) - offset);
-        uint16_t xy = XY(x, y);
-        rgb24Buffer[xy] = color;
-
-        EVERY_N_MILLIS(25)
-        {
-          theta1 += 2;
-          hueOffset += 1;
-        }
+        rgb24 color = palette.color(hue);
+        canvas.setIndex(streamRings.ring(offset)[theta1], color);
       }
     }
 
@@ -1191,12 +1397,14 @@ class AudioPatterns {
     void white()
     {
       // fill with white
-      backgroundLayer.fillScreen(WHITE);
-      backgroundLayer.swapBuffers();
+      canvas.fillScreen(WHITE);
+      while (!canvas.present())
+        ;
 
       delay(5000);
 
-      backgroundLayer.fillScreen(BLACK);
-      backgroundLayer.swapBuffers();
+      canvas.fillScreen(BLACK);
+      while (!canvas.present())
+        ;
     }
 };
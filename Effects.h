@@ -32,17 +32,6 @@ extern rgb24* rgb24Buffer;
 
 // non-class prototypes
 void FillNoiseCentral(uint8_t scale);
-CRGB HsvToRgb(uint8_t h, uint8_t s, uint8_t v);
-
-
-
-CRGB HsvToRgb(uint8_t h, uint8_t s, uint8_t v)
-{
-  CHSV hsv = CHSV(h, s, v);
-  CRGB rgb;
-  hsv2rgb_spectrum(hsv, rgb);
-  return rgb;
-}
 
 
 
@@ -83,7 +72,8 @@ class Effects {
 
     void updateBuffer()
     {
-      rgb24Buffer = backgroundLayer.backBuffer();
+      rgb24Buffer = canvas.buffer();
+      fb.attach(rgb24Buffer, canvas.renderShift(), canvas.scrollTop());
     }
 
 
@@ -138,16 +128,22 @@ class Effects {
     }
 
 
-    // calculate noise matrix x and y define the center
-    void FillNoiseCentral(uint8_t scale)
+    // calculate noise matrix x and y define the center.
+    // step > 1 only calculates every step pixels and copies
+    // the value to the rest of the block
+    void FillNoiseCentral(uint8_t scale, uint8_t step = 1)
     {
-      for (uint16_t i = 0; i < kScreenWidth; i++)
+      for (uint16_t i = 0; i < kScreenWidth; i += step)
       {
         int ioffset = scale * (i - 8);
-        for (uint16_t j = 0; j < kScreenHeight; j++)
+        for (uint16_t j = 0; j < kScreenHeight; j += step)
         {
           uint16_t joffset = scale * (j - 8);
-          noise[i][j] = inoise8(noiseX + ioffset, noiseY + joffset, noiseZ);
+          uint8_t data = inoise8(noiseX + ioffset, noiseY + joffset, noiseZ);
+
+          for (uint16_t bi = i; bi < i + step && bi < kScreenWidth; bi++)
+            for (uint16_t bj = j; bj < j + step && bj < kScreenHeight; bj++)
+              noise[bi][bj] = data;
         }
       }
     }
@@ -159,17 +155,15 @@ class Effects {
     // give it a linear tail downwards
     void StreamDown(uint8_t scale)
     {
-      for (uint16_t x = 0; x < kScreenWidth; x++)
-      {
-        for (uint16_t y = 1; y < kScreenHeight; y++)
-        {
-          rgb24Buffer[XY(x, y)] += rgb24Buffer[XY(x, y - 1)];
-          rgb24Buffer[XY(x, y)].nscale8(scale);
-        }
-      }
+      beginPass();
+
+      // top to bottom, each row takes the tail from the one
+      // above after it's been streamed
+      for (uint16_t y = 1; y < kScreenHeight; y++)
+        streamRow(y, y - 1, 0, 0, kScreenWidth, scale);
 
-      for (uint16_t x = 0; x < kScreenWidth; x++)
-        rgb24Buffer[XY(x, kScreenHeight - 1)].nscale8(scale);
+      fadeRow(kScreenHeight - 1, 0, kScreenWidth, scale);
+      endPass();
     }
 
 
@@ -178,17 +172,13 @@ class Effects {
     // give it a linear tail upwards
     void StreamUp(uint8_t scale)
     {
-      for (uint16_t x = 0; x < kScreenWidth; x++)
-      {
-        for (uint16_t y = kScreenHeight - 2; y > 0; y--)
-        {
-          rgb24Buffer[XY(x, y)] += rgb24Buffer[XY(x, y + 1)];
-          rgb24Buffer[XY(x, y)].nscale8(scale);
-        }
-      }
+      beginPass();
+
+      for (uint16_t y = kScreenHeight - 2; y > 0; y--)
+        streamRow(y, y + 1, 0, 0, kScreenWidth, scale);
 
-      for (uint16_t x = 0; x < kScreenWidth; x++)
-        rgb24Buffer[XY(x, kScreenHeight - 1)].nscale8(scale);
+      fadeRow(kScreenHeight - 1, 0, kScreenWidth, scale);
+      endPass();
     }
 
 
@@ -197,17 +187,39 @@ class Effects {
     // give it a linear tail to the right
     void StreamRight(uint8_t scale, uint16_t fromX = 0, uint16_t toX = kScreenWidth, uint16_t fromY = 0, uint16_t toY = kScreenHeight)
     {
-      for (uint16_t x = fromX + 1; x < toX; x++)
+      beginPass();
+
+      // each pixel takes the tail from the one just streamed, so
+      // this one goes a pixel at a time along the row. A black
+      // tile is only worked on if the tail reaches into it
+      for (uint16_t y = fromY; y < toY; y++)
       {
-        for (uint16_t y = fromY; y < toY; y++)
+        rgb24* row = fb.row(y);
+        uint32_t bits = canvas.tileRowBits(y >> TILE_SHIFT);
+
+        for (uint16_t x0 = fromX + 1; x0 < toX; )
         {
-          rgb24Buffer[XY(x, y)] += rgb24Buffer[XY(x - 1, y)];
-          rgb24Buffer[XY(x, y)].nscale8(scale);
+          uint8_t tx = x0 >> TILE_SHIFT;
+          uint16_t x1 = min((uint16_t)((tx + 1) << TILE_SHIFT), toX);
+
+          if ((bits >> tx) & 1 || isLit(row[x0 - 1]))
+          {
+            uint8_t lit = 0;
+            for (uint16_t x = x0; x < x1; x++)
+            {
+              row[x] += row[x - 1];
+              row[x].nscale8(scale);
+              lit |= row[x].red | row[x].green | row[x].blue;
+            }
+            worked(y, tx, lit);
+          }
+          x0 = x1;
         }
+
+        row[0].nscale8(scale);
       }
 
-      for (uint16_t y = fromY; y < toY; y++)
-        rgb24Buffer[XY(0, y)].nscale8(scale);
+      endPass();
     }
 
 
@@ -215,16 +227,19 @@ class Effects {
     // give it a linear tail to the left
     void StreamLeft(uint8_t scale, uint16_t fromX = kScreenWidth, uint16_t toX = 0, uint16_t fromY = 0, uint16_t toY = kScreenHeight)
     {
-      for (uint16_t x = toX; x < fromX - 1; x++)
+      beginPass();
+
+      // left to right, each pixel takes the tail from the pixel
+      // to its right before that's been streamed
+      for (uint16_t y = fromY; y < toY; y++)
       {
-        for (uint16_t y = fromY; y < toY; y++)
-        {
-          rgb24Buffer[XY(x, y)] += rgb24Buffer[XY(x + 1, y)];
-          rgb24Buffer[XY(x, y)].nscale8(scale);
-        }
+        if (fromX > toX + 1)
+          streamRow(y, y, 1, toX, fromX - 1, scale);
+
+        fb.row(y)[0].nscale8(scale);
       }
-      for (uint16_t y = fromY; y < toY; y++)
-        rgb24Buffer[XY(0, y)].nscale8(scale);
+
+      endPass();
     }
 
 
@@ -232,19 +247,18 @@ class Effects {
     // give it a linear tail up and to the left
     void StreamUpAndLeft(uint8_t scale)
     {
-      for (uint16_t x = 0; x < kScreenWidth - 1; x++)
-      {
-        for (uint16_t y = kScreenHeight - 2; y > 0; y--)
-        {
-          rgb24Buffer[XY(x, y)] += rgb24Buffer[XY(x + 1, y + 1)];
-          rgb24Buffer[XY(x, y)].nscale8(scale);
-        }
-      }
-      for (uint16_t x = 1; x < kScreenWidth; x++)
-        rgb24Buffer[XY(x, kScreenHeight - 1)].nscale8(scale);
+      beginPass();
+
+      // top to bottom, so the row below is still untouched
+      for (uint16_t y = 1; y < kScreenHeight - 1; y++)
+        streamRow(y, y + 1, 1, 0, kScreenWidth - 1, scale);
+
+      fadeRow(kScreenHeight - 1, 1, kScreenWidth, scale);
 
       for (uint16_t y = 0; y < kScreenHeight; y++)
-        rgb24Buffer[XY(kScreenWidth - 1, y)].nscale8(scale);
+        fb.row(y)[kScreenWidth - 1].nscale8(scale);
+
+      endPass();
     }
 
 
@@ -252,22 +266,34 @@ class Effects {
     // give it a linear tail up and to the right
     void StreamUpAndRight(uint8_t scale)
     {
-      for (uint16_t x = 0; x < kScreenWidth - 1; x++)
+      beginPass();
+
+      // bottom to top, each row takes the tail from the one below
+      // after it's been streamed. The last column only gets the
+      // tail, it's faded with the right column below
+      for (uint16_t y = kScreenHeight - 2; y > 0; y--)
       {
-        for (uint16_t y = kScreenHeight - 2; y > 0; y--)
+        rgb24* row = fb.row(y);
+        rgb24* below = fb.row(y + 1);
+
+        row[0].nscale8(scale);
+        streamRow(y, y + 1, -1, 1, kScreenWidth - 1, scale);
+
+        if (isLit(below[kScreenWidth - 2]))
         {
-          rgb24Buffer[XY(x + 1, y)] += rgb24Buffer[XY(x, y + 1)];
-          rgb24Buffer[XY(x, y)].nscale8(scale);
+          row[kScreenWidth - 1] += below[kScreenWidth - 2];
+          canvas.markPixel(kScreenWidth - 1, y);
         }
       }
 
       // fade the bottom row
-      for (uint16_t x = 0; x < kScreenWidth; x++)
-        rgb24Buffer[XY(x, kScreenHeight - 1)].nscale8(scale);
+      fadeRow(kScreenHeight - 1, 0, kScreenWidth, scale);
 
       // fade the right column
       for (uint16_t y = 0; y < kScreenHeight; y++)
-        rgb24Buffer[XY(kScreenWidth - 1, y)].nscale8(scale);
+        fb.row(y)[kScreenWidth - 1].nscale8(scale);
+
+      endPass();
     }
 
 
@@ -285,288 +311,227 @@ class Effects {
         // i = 32 - 0 - 1;  i < 32 + 0; i++)
         for (uint16_t i = x - d - 1; i < x + d; i++)
         {
-          rgb24Buffer[XY(i, y - d)] += rgb24Buffer[XY(i + 1, y - d)]; // lowest row to the right
-          rgb24Buffer[XY(i, y - d)].nscale8(dim);
+          fb.at(i, y - d) += fb.at(i + 1, y - d); // lowest row to the right
+          fb.at(i, y - d).nscale8(dim);
         }
 
         for (uint16_t i = y - d; i < y + d; i++)
         {
-          rgb24Buffer[XY(x + d, i)] += rgb24Buffer[XY(x + d, i + 1)]; // right colum up
-          rgb24Buffer[XY(x + d, i)].nscale8(dim);
+          fb.at(x + d, i) += fb.at(x + d, i + 1); // right colum up
+          fb.at(x + d, i).nscale8(dim);
         }
 
         for (uint16_t i = x + d; i > x - d; i--)
         {
-          rgb24Buffer[XY(i, y + d)] += rgb24Buffer[XY(i - 1, y + d)]; // upper row to the left
-          rgb24Buffer[XY(i, y + d)].nscale8(dim);
+          fb.at(i, y + d) += fb.at(i - 1, y + d); // upper row to the left
+          fb.at(i, y + d).nscale8(dim);
         }
 
         for (uint16_t i = y + d; i > y - d; i--)
         {
-          rgb24Buffer[XY(x - d, i)] += rgb24Buffer[XY(x - d, i - 1)]; // left colum down
-          rgb24Buffer[XY(x - d, i)].nscale8(dim);
+          fb.at(x - d, i) += fb.at(x - d, i - 1); // left colum down
+          fb.at(x - d, i).nscale8(dim);
         }
       }
+
+      canvas.markArea(x - r - 1, y - r, x + r, y + r);
     }
 
 
 
-    void CircleStream(uint8_t value)
+    // SpiralStream on the top left quarter of each ring only, for
+    // patterns that mirror the quarter to the rest (symmetry.h)
+    void SpiralStreamQuarter(uint16_t x, uint16_t y, uint16_t r, uint8_t dim)
     {
-      rgb24DimAll(value);
-
-      for (uint8_t offset = 0; offset < (uint8_t )kMatrixCenterX; offset++)
+      for (uint16_t d = r; d > 0; d--)
       {
-        boolean hasprev = false;
-        uint16_t prevxy = 0;
+        if (d >= x || d > y)
+          continue;
 
-        for (uint8_t theta = 0; theta < 255; theta++)
+        rgb24* top = fb.row(y - d);
+        for (uint16_t i = x - d - 1; i < x; i++)
         {
-          uint16_t x1 = mapcos8(theta, offset, (kScreenWidth - 1 - 1) - offset);
-          uint16_t y1 = mapsin8(theta, offset, (kScreenHeight - 1 - 1) - offset);
-          uint16_t xy = XY(x1, y1);
-
-          if (hasprev)
-          {
-            ledArray2[prevxy] += rgb24Buffer[xy];
-          }
-
-          prevxy = xy;
-          hasprev = true;
+          top[i] += top[i + 1]; // top row to the left
+          top[i].nscale8(dim);
         }
-      }
 
-      for (uint16_t i = 0; i < kScreenWidth; i++)
-      {
-        for (uint16_t j = 0; j < kScreenHeight; j++)
+        for (uint16_t i = y; i > y - d; i--)
         {
-          uint16_t xy = XY(i, j);
-          rgb24Buffer[xy] = ledArray2[xy];
-          rgb24Buffer[xy].nscale8(value);
-          ledArray2[xy].nscale8(value);
+          fb.row(i)[x - d] += fb.row(i - 1)[x - d]; // left column down
+          fb.row(i)[x - d].nscale8(dim);
         }
       }
-    }
-
 
-
-    // spread pixel horizontally
-    void smearHorizontal(uint8_t scale)
-    {
-
-      for (uint16_t x = 0; x < kScreenWidth; x++)
-      {
-        for (uint16_t y = 0; y < kScreenHeight; y++)
-        {
-          rgb24Buffer[XY(x, y)] += rgb24Buffer[XY(x - 1, y)];
-          rgb24Buffer[XY(x, y)] += rgb24Buffer[XY(x, y)];
-          rgb24Buffer[XY(x, y)] += rgb24Buffer[XY(x + 1, y)];
-          rgb24Buffer[XY(x, y)].nscale8(scale);
-        }
-      }
+      canvas.markArea(x - r - 1, y - r, x, y);
     }
 
 
 
-    // rotates the first 16x16 quadrant 3 times onto a +90 degrees rotation for each one)
-    void Caleidoscope1()
+    void CircleStream(uint8_t value)
     {
-      for (int x = 0; x < 32; x++)
-      {
-        for (int y = 0; y < 32; y++)
-        {
-          // 1st copy
-          rgb24Buffer[XY(63 - x, y)] = rgb24Buffer[XY(x, y)];
+      rgb24DimAll(value);
 
-          // 2nd copy
-          rgb24Buffer[XY(63 - x, 63 - y)] = rgb24Buffer[XY(x, y)];
+      for (uint8_t offset = 0; offset < (uint8_t )kMatrixCenterX; offset++)
+      {
+        const uint16_t* ring = streamRings.ring(offset);
 
-          // 3rd
-          rgb24Buffer[XY(x, 63 - y)] = rgb24Buffer[XY(x, y)];
-        }
+        for (uint8_t theta = 1; theta < 255; theta++)
+          ledArray2[ring[theta - 1]] += rgb24Buffer[ring[theta]];
       }
-    }
 
-
-    // mirror the first 16x16 quadrant 3 times onto a 32x32
-    void Caleidoscope2()
-    {
-      for (uint16_t x = 0; x < 16; x++)
+      for (uint16_t j = 0; j < kScreenHeight; j++)
       {
-        for (uint16_t y = 0; y < 16; y++)
-        {
-          rgb24Buffer[XY(31 - x, y)]  = rgb24Buffer[XY(y, x)];
-          rgb24Buffer[XY(x, 31 - y)] = rgb24Buffer[XY(y, x)];
-          rgb24Buffer[XY(31 - x, 31 - y)] = rgb24Buffer[XY(x, y)];
-        }
-      }
-    }
-
+        rgb24* row = fb.row(j);
+        rgb24* row2 = &ledArray2[fb.index(0, j)];
 
-    // copy one diagonal triangle into the other one within a 16x16
-    void Caleidoscope3()
-    {
-      for (uint16_t x = 0; x < 16; x++)
-      {
-        for (uint16_t y = 0; y <= x; y++)
+        for (uint16_t i = 0; i < kScreenWidth; i++)
         {
-          rgb24Buffer[XY(x, y)] = rgb24Buffer[XY(y, x)];
+          row[i] = row2[i];
+          row[i].nscale8(value);
+          row2[i].nscale8(value);
         }
       }
-    }
-
 
-
-    // copy one diagonal triangle into the other one within a 16x16 (90 degrees rotated compared to Caleidoscope3)
-    void Caleidoscope4()
-    {
-      for (uint16_t x = 0; x < 16; x++)
-      {
-        for (uint16_t y = 0; y <= 16 - x; y++)
-        {
-          rgb24Buffer[XY(32 - y, 32 - x)] = rgb24Buffer[XY(x, y)];
-        }
-      }
+      canvas.markAll();
     }
 
 
 
-    // copy one diagonal triangle into the other one within a 8x8
-    void Caleidoscope5()
+    // spread pixel horizontally
+    void smearHorizontal(uint8_t scale)
     {
-      for (uint16_t x = 0; x < 8; x++)
-      {
-        for (uint16_t y = 0; y <= x; y++)
-        {
-          rgb24Buffer[XY(x, y)] = rgb24Buffer[XY(y, x)];
-        }
-      }
+      beginPass();
 
-      for (uint16_t x = 8; x < 16; x++)
+      // left to right, a pixel at a time like StreamRight(). Each
+      // takes from the one to its right too, so a black tile is
+      // worked on if either neighbour pixel is lit
+      for (uint16_t y = 0; y < kScreenHeight; y++)
       {
-        for (uint16_t y = 16; y > 0; y--)
+        rgb24* row = fb.row(y);
+        uint32_t bits = canvas.tileRowBits(y >> TILE_SHIFT);
+
+        for (uint16_t x0 = 1; x0 < kScreenWidth; )
         {
-          rgb24Buffer[XY(x, y)] = rgb24Buffer[XY(y, x)];
+          uint8_t tx = x0 >> TILE_SHIFT;
+          uint16_t x1 = min((tx + 1) << TILE_SHIFT, (int)kScreenWidth);
+
+          if ((bits >> tx) & 1 || isLit(row[x0 - 1]) || isLit(row[x1]))
+          {
+            uint8_t lit = 0;
+            for (uint16_t x = x0; x < x1; x++)
+            {
+              row[x] += row[x - 1];
+              row[x] += row[x];
+              row[x] += row[x + 1];
+              row[x].nscale8(scale);
+              lit |= row[x].red | row[x].green | row[x].blue;
+            }
+            worked(y, tx, lit);
+          }
+          x0 = x1;
         }
       }
-    }
-
 
+      endPass();
+    }
 
-    void Caleidoscope6()
-    {
-      for (uint16_t x = 1; x < 16; x++) //a
-        rgb24Buffer[XY(17 - x, 7)] = rgb24Buffer[XY(x, 0)];
-
-      for (uint16_t x = 2; x < 16; x++) //b
-        rgb24Buffer[XY(17 - x, 6)] = rgb24Buffer[XY(x, 1)];
-
-      for (uint16_t x = 3; x < 16; x++) //c
-        rgb24Buffer[XY(17 - x, 5)] = rgb24Buffer[XY(x, 2)];
-
-      for (uint16_t x = 4; x < 16; x++) //d
-        rgb24Buffer[XY(17 - x, 4)] = rgb24Buffer[XY(x, 3)];
 
-      for (uint16_t x = 5; x < 16; x++) //e
-        rgb24Buffer[XY(17 - x, 3)] = rgb24Buffer[XY(x, 4)];
+  private:
+    // tiles each pass worked on, and the ones that came out lit
+    uint32_t _worked[MAX_TILE_ROWS];
+    uint32_t _lit[MAX_TILE_ROWS];
 
-      for (uint16_t x = 6; x < 16; x++) //f
-        rgb24Buffer[XY(17 - x, 2)] = rgb24Buffer[XY(x, 5)];
 
-      for (uint16_t x = 7; x < 16; x++) //g
-        rgb24Buffer[XY(17 - x, 1)] = rgb24Buffer[XY(x, 6)];
+    bool isLit(const rgb24& pixel)
+    {
+      return (pixel.red | pixel.green | pixel.blue) != 0;
     }
 
 
+    void beginPass()
+    {
+      for (uint8_t ty = 0; ty < canvas.tileRows(); ty++)
+        _worked[ty] = _lit[ty] = 0;
+    }
 
 
-    // copy x pixels from 0, startingY to 0, y + startingY + numY
-    void mirrorDown(uint16_t startingX, uint16_t startingY, uint16_t numX, uint16_t numY)
+    // a tile that came out lit is marked straight away, so the
+    // rows after it see it. Worked tiles that stayed black may
+    // still have pixels the pass didn't touch, they're checked
+    // before the bit is cleared
+    void worked(uint16_t y, uint8_t tx, uint8_t lit)
     {
-#ifdef CHECK_BOUNDS
-      if (startingY > kScreenHeight - numY || startingX > kScreenWidth - numX )
-      {
-        Serial.println("mirrorDown Start Out of Bounds");
-        return;
-      }
-
-      if (startingY + numY > kScreenHeight || startingX + numX > kScreenWidth)
-      {
-        Serial.println("mirrorDown Span Out of Bounds");
-        return;
-      }
-#endif
+      uint8_t ty = y >> TILE_SHIFT;
+      _worked[ty] |= 1UL << tx;
 
-      for (uint16_t x = startingX; x < startingX + numX; x++)
+      if (lit)
       {
-        for (uint16_t y = startingY; y < startingY + numY; y++)
-        {
-          rgb24Buffer[XY(x, y + numY)] = rgb24Buffer[XY(x, y)];
-        }
+        _lit[ty] |= 1UL << tx;
+        canvas.markTile(tx, ty);
       }
     }
 
 
-
-
-
-    void mirrorLeft(uint16_t startingX, uint16_t startingY, uint16_t numX, uint16_t numY)
+    void endPass()
     {
-      for (uint16_t x = startingX; x < startingX + numX; x++)
+      for (uint8_t ty = 0; ty < canvas.tileRows(); ty++)
       {
-        for (uint16_t y = startingY; y < startingY + numY; y++)
+        uint32_t dark = _worked[ty] & ~_lit[ty];
+
+        for (uint8_t tx = 0; dark != 0; tx++, dark >>= 1)
         {
-          rgb24Buffer[XY(x + numX, y)] = rgb24Buffer[XY(x, y)];
+          if ((dark & 1) && canvas.tileIsBlack(tx, ty))
+            canvas.clearTile(tx, ty);
         }
       }
     }
 
 
-
-
-    // copy top left 64x32 area down into lower left 64x32 area
-    void mirror64down()
+    // row y = scale8(row y + row srcY moved left by shift pixels)
+    // for x0 .. x1 - 1, a tile at a time. Tiles that are black in
+    // row y and in the tiles of srcY the tail comes from are left
+    void streamRow(uint16_t y, uint16_t srcY, int8_t shift, uint16_t x0, uint16_t x1, uint8_t scale)
     {
-      if (kScreenWidth < 64)
-        return;
+      rgb24* row = fb.row(y);
+      const rgb24* src = fb.row(srcY);
+
+      uint32_t srcBits = canvas.tileRowBits(srcY >> TILE_SHIFT);
+      if (shift > 0)
+        srcBits |= srcBits >> 1;
+      else if (shift < 0)
+        srcBits |= srcBits << 1;
+      uint32_t active = canvas.tileRowBits(y >> TILE_SHIFT) | srcBits;
 
-      for (uint16_t x = 0; x < 64; x++)
+      while (x0 < x1)
       {
-        for (uint16_t y = 0; y < 64; y++)
+        uint8_t tx = x0 >> TILE_SHIFT;
+        uint16_t end = min((uint16_t)((tx + 1) << TILE_SHIFT), x1);
+
+        if ((active >> tx) & 1)
         {
-          rgb24Buffer[XY(x, y + 64)] = rgb24Buffer[XY(x, y)];
+          uint8_t lit = addScale8Bytes((uint8_t*)&row[x0], (const uint8_t*)&src[x0 + shift],
+                                       (end - x0) * sizeof(rgb24), scale);
+          worked(y, tx, lit);
         }
+        x0 = end;
       }
     }
 
 
-    // copy left 64x64 pixels of matrix to next 64x64 pixels
-    void mirror64Left()
+    // scale8() row y for x0 .. x1 - 1, only the tiles that are lit
+    void fadeRow(uint16_t y, uint16_t x0, uint16_t x1, uint8_t scale)
     {
-      if (kScreenWidth < 128)
-        return;
+      rgb24* row = fb.row(y);
+      uint32_t bits = canvas.tileRowBits(y >> TILE_SHIFT);
 
-      for (uint16_t x = 0; x < 64; x++)
+      while (x0 < x1)
       {
-        for (uint16_t y = 0; y < 64; y++)
-        {
-          rgb24Buffer[XY(x + 64, y)] = rgb24Buffer[XY(x, y)];
-        }
-      }
-    }
-
+        uint8_t tx = x0 >> TILE_SHIFT;
+        uint16_t end = min((uint16_t)((tx + 1) << TILE_SHIFT), x1);
 
-
-    // just move everything one line down
-    void MoveDown()
-    {
-      for (uint16_t y = kScreenHeight - 1; y > 1; y--)
-      {
-        for (uint16_t x = 0; x < kScreenWidth; x++)
-        {
-          rgb24Buffer[XY(x, y)] = rgb24Buffer[XY(x, y - 1)];
-        }
+        if ((bits >> tx) & 1)
+          worked(y, tx, scale8Bytes((uint8_t*)&row[x0], (end - x0) * sizeof(rgb24), scale));
+        x0 = end;
       }
     }
-
-};
+};
\ No newline at end of file
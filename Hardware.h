@@ -58,11 +58,14 @@
 
 
 // ------>  define the target display <-------
+// (the host build sets it for each display, see CMakeLists.txt)
 
+#ifndef HOST_BUILD
 #define BIG_MUSIC_FRAME
 //#define LIL_MUSIC_FRAME
 //#define STEREO_CABINET
 //#define XLIGHTS
+#endif
 
 
 
@@ -81,6 +84,10 @@
 #define PLATFORM "Teensy_40"
 #elif defined ARDUINO_TEENSY41
 #define PLATFORM "Teensy_41"
+#elif defined HOST_BUILD
+// desktop build for timing/debug, the SmartMatrix, FastLED & Arduino
+// libraries are the stand-ins in host/, see CMakeLists.txt
+#define PLATFORM "Host"
 #else
 #pragma GCC error "No valid Teensy ID Found - Select TEENSY from Tools -> Boards"
 #endif
@@ -94,6 +101,17 @@
 //#define SM_SHOW_MESSAGES
 
 #define AUTO_SWITCH_DURATION 60000
+#define AUTO_SWITCH_GRACE    4000     // max wait for a downbeat after that
+
+// USE_TRIPLE_BUFFER (set per display below) draws into a third
+// buffer so frames don't wait for the refresh. It costs
+// width x height x 3 bytes of DMAMEM, see canvas.h
+
+// USE_RENDER_SCALE lets the plasmas draw at 1/2 or 1/4 size on
+// displays without the triple buffer, for another width x height
+// x 3 / 4 bytes of DMAMEM. The triple buffer ones always can,
+// the small frame shares the third buffer
+//#define USE_RENDER_SCALE
 
 
 
@@ -121,6 +139,7 @@
 
 // setting for this display
 #define USE_SERIAL
+#define USE_TRIPLE_BUFFER
 //#define INCLUDE_LIFE
 //#define USE_IR_REMOTE
 //#define USE_DMX
@@ -152,6 +171,7 @@
 
 // setting for this display
 #define USE_SERIAL
+//#define USE_TRIPLE_BUFFER
 #define INCLUDE_LIFE
 //#define USE_IR_REMOTE
 //#define USE_DMX
@@ -193,6 +213,7 @@
 
 // setting for this display
 #define USE_SERIAL
+//#define USE_TRIPLE_BUFFER
 #define INCLUDE_LIFE
 //#define USE_IR_REMOTE
 //#define USE_DMX
@@ -234,6 +255,7 @@
 
 // setting for this display
 #define USE_SERIAL
+//#define USE_TRIPLE_BUFFER
 #define INCLUDE_LIFE
 //#define USE_IR_REMOTE
 //#define USE_DMX
@@ -70,7 +70,7 @@ void Life :: createWorld()
   //printValue("Creating World");
 
   // clear display
-  backgroundLayer.fillScreen(BLACK);
+  canvas.fillScreen(BLACK);
   delay(2000);
 
   for (uint16_t x = 0; x < kMatrixWidth; x++)
@@ -110,14 +110,13 @@ void Life :: updateWorld()
     for (uint16_t y = 0; y < kMatrixHeight; y++)
     {
       if (!cells[x][y].alive)
-        backgroundLayer.drawPixel(x, y, BLACK);
+        canvas.drawPixel(x, y, BLACK);
       else
-        backgroundLayer.drawPixel(x, y, wheel8(cells[x][y].color));  // was wheel8Sat
+        canvas.drawPixel(x, y, palette.color(cells[x][y].color));
     }
   }
 
-  // update display
-  backgroundLayer.swapBuffers();
+  // the display is updated by AudioPatterns::update()
   newCells = 0;
 
   // Birth and death cycle
@@ -182,9 +181,6 @@ void Life :: updateWorld()
     //printValue("generation", generation);
     generation = 0;
   }
-
-  // finally, slow things down a bit
-  delay(delayVal * 5);
 }
 
 
@@ -179,7 +179,7 @@ void Star :: setPattern(int8_t mode)
   {
     case 0:
       // increase speed with volume
-      speed = 0.50 + (avgLevel / 300);
+      speed = 0.50 + (avgLevel / 300.0);
       speed = constrain(speed, 0.25, 2.0);
       _xSpeed = cos(angle) * speed;
       _ySpeed = sin(angle) * speed;
@@ -197,7 +197,7 @@ void Star :: setPattern(int8_t mode)
     // long tails
     case 1:
       // increase speed with volume
-      speed = 0.50 + (avgLevel / 300);
+      speed = 0.50 + (avgLevel / 300.0);
       speed = constrain(speed, 0.25, 2.0);
 
       // calc x & y speeds
@@ -238,17 +238,10 @@ void Star :: tick()
   // old method to erase star if dimming is not used
   // eraseStar();
 
-  // color mode 4 must be updated while star is moving
-  if (colorMode == 4)
-  {
-    // calc distance from center
-    float x = pos(_x - kMatrixCenterX);
-    float y = pos(_y - kMatrixCenterY);
-    float dist = sqrt((x * x) + (y * y));
-    // scale for best looking color range
-    dist = constrain(dist * (180 / kMatrixCenterX), 0, 255);
-    _color = wheel8Sat(((uint8_t)dist & 255), 84);
-  }
+  // color mode 3 is updated while star is moving, by the
+  // distance from the center (polar.h)
+  if (colorMode == 3)
+    _color = wheel8Sat(polar.radius(_x, _y), 84);
 
   // increment x & y positions
   _x += _xSpeed;
@@ -289,7 +282,7 @@ void Star :: tick()
 
 void Star :: eraseStar()
 {
-  backgroundLayer.drawPixel((uint16_t)_x, (uint16_t)_y, BLACK);
+  canvas.drawPixel((uint16_t)_x, (uint16_t)_y, BLACK);
 }
 
 
@@ -301,7 +294,7 @@ void Star :: drawStar()
     return;
 
   // draw the pixel (a.k.a. star)
-  backgroundLayer.drawPixel(uint16_t(_x), uint16_t(_y), _color);
+  canvas.drawPixel(uint16_t(_x), uint16_t(_y), _color);
 
 }
 
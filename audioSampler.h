@@ -0,0 +1,177 @@
+/*************************************************************
+
+   audioSampler.h - reads the MSGEQ7 in the background using
+   an IntervalTimer instead of busy-waiting in getAudioData().
+
+   Each timer tick advances a small state machine one step:
+   reset pulse, wait, then strobe low / start the conversion /
+   collect it & strobe high for each of the 7 bands. The ADC
+   converts between two ticks (ADC library startSingleRead() /
+   readSingle()) so the ISR never waits on analogRead(). A
+   complete set of bands is written to one half of a double
+   buffer and then published, so readAudio() just copies the
+   latest set. A full cycle takes 24 ticks (~960 uS) and repeats
+   continuously, independent of how long a pattern takes to
+   draw. Each set is stamped with the time it completed so a
+   frame always draws with the newest bands and the audio to
+   light latency can be measured.
+
+   MSGEQ7Source (audioSource.h) starts and stops it, so it only
+   runs while the MSGEQ7 is the source and leaves the ADC to the
+   fft sampler otherwise.
+
+   Tick timing (40 uS) meets the MSGEQ7 requirements:
+   reset to strobe 80 uS, strobe width 80 uS, strobe to
+   strobe 120 uS, output settling 40 uS before the conversion
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include <ADC.h>
+
+
+#define MSGEQ7_TICK_US          40
+#define MSGEQ7_TIMER_PRIORITY   192   // below the SmartMatrix refresh
+
+
+// prototypes
+void startAudioSampler();
+void stopAudioSampler();
+void sampleAudioISR();
+bool getSampledBands(uint16_t* bands, uint32_t* timestamp);
+
+
+// sampler states
+enum {
+  SAMPLE_RESET,
+  SAMPLE_RESET_LOW,
+  SAMPLE_RESET_WAIT,
+  SAMPLE_STROBE,
+  SAMPLE_CONVERT,
+  SAMPLE_READ
+};
+
+
+IntervalTimer audioTimer;
+ADC* adc = new ADC();
+
+// double buffered band values, written only by the ISR
+volatile uint16_t sampleBuffer[2][EQ_BANDS7];
+volatile uint32_t sampleTime[2];            // micros() when each set completed
+volatile uint8_t  sampleReadyIndex = 0;     // buffer holding the newest complete set
+volatile uint32_t sampleCount = 0;          // number of complete sets captured
+
+uint8_t sampleState = SAMPLE_RESET;
+uint8_t sampleBand = 0;
+uint8_t sampleWriteIndex = 1;
+uint32_t lastSampleCount = 0;
+
+
+
+
+void startAudioSampler()
+{
+  sampleState = SAMPLE_RESET;
+  sampleBand = 0;
+
+  // same as analogRead() gave
+  adc->adc0->setResolution(10);
+  adc->adc0->setAveraging(1);
+
+  audioTimer.priority(MSGEQ7_TIMER_PRIORITY);
+  audioTimer.begin(sampleAudioISR, MSGEQ7_TICK_US);
+}
+
+
+
+// leaves the strobe high, as between bands
+void stopAudioSampler()
+{
+  audioTimer.end();
+  digitalWriteFast(MSGEQ7_STROBE_PIN, HIGH);
+}
+
+
+
+
+// one step of the MSGEQ7 read sequence per timer tick
+void sampleAudioISR()
+{
+  switch (sampleState)
+  {
+    case SAMPLE_RESET:
+      digitalWriteFast(MSGEQ7_RESET_PIN, HIGH);
+      sampleState = SAMPLE_RESET_LOW;
+      break;
+
+    case SAMPLE_RESET_LOW:
+      digitalWriteFast(MSGEQ7_RESET_PIN, LOW);
+      sampleState = SAMPLE_RESET_WAIT;
+      break;
+
+    case SAMPLE_RESET_WAIT:
+      sampleBand = 0;
+      sampleState = SAMPLE_STROBE;
+      break;
+
+    case SAMPLE_STROBE:
+      digitalWriteFast(MSGEQ7_STROBE_PIN, LOW);
+      sampleState = SAMPLE_CONVERT;
+      break;
+
+    // output has settled, it's done long before the next tick
+    case SAMPLE_CONVERT:
+      adc->adc0->startSingleRead(MSGEQ7_AUDIO_PIN);
+      sampleState = SAMPLE_READ;
+      break;
+
+    case SAMPLE_READ:
+      sampleBuffer[sampleWriteIndex][sampleBand] = adc->adc0->readSingle();
+      digitalWriteFast(MSGEQ7_STROBE_PIN, HIGH);
+
+      sampleBand++;
+      if (sampleBand < EQ_BANDS7)
+      {
+        sampleState = SAMPLE_STROBE;
+      }
+      else
+      {
+        // publish the completed set & start filling the other one
+        sampleTime[sampleWriteIndex] = micros();
+        sampleReadyIndex = sampleWriteIndex;
+        sampleWriteIndex ^= 1;
+        sampleCount++;
+        sampleState = SAMPLE_RESET;
+      }
+      break;
+
+    default:
+      sampleState = SAMPLE_RESET;
+  }
+}
+
+
+
+
+// copy the newest complete set of bands and its capture time,
+// returns false if nothing new was captured since the last call
+bool getSampledBands(uint16_t* bands, uint32_t* timestamp)
+{
+  noInterrupts();
+  uint8_t index = sampleReadyIndex;
+  uint32_t count = sampleCount;
+  for (uint8_t band = 0; band < EQ_BANDS7; band++)
+    bands[band] = sampleBuffer[index][band];
+  *timestamp = sampleTime[index];
+  interrupts();
+
+  bool fresh = (count != lastSampleCount);
+  lastSampleCount = count;
+
+  return fresh;
+}
@@ -0,0 +1,463 @@
+/*************************************************************
+
+   audioSource.h - where the raw band values come from
+
+   Every source returns 7 raw 10-bit band values per frame, the
+   same as the MSGEQ7, plus the time they were captured. The
+   rest of readAudio.h (background removal, AGC, peaks) doesn't
+   care which source is in use.
+
+   Sources:
+   MSGEQ7Source  - the MSGEQ7 chip (default)
+   SimAudioSource - random levels, 8 sec on / 2 sec off
+   ReplaySource  - plays a table of recorded band frames, one
+                   frame per read so runs are repeatable
+   WavSource     - plays a 16-bit PCM WAV file from the SD card
+                   through a software 7-band filter bank.
+                   Needs USE_SD_AUDIO (see readAudio.h)
+   FftSource     - software FFT of the line input, see fftAudio.h
+                   Needs USE_FFT_AUDIO (see readAudio.h)
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include "audioTrace.h"
+
+#ifdef USE_SD_AUDIO
+#include <SD.h>
+#endif
+
+
+// prototypes
+class AudioSource;
+void selectAudioSource(uint8_t index);
+AudioSource* currentAudioSource();
+
+
+
+class AudioSource {
+  public:
+    virtual void begin() {}
+    virtual void end() {}           // another source was selected
+    virtual void rewind() {}
+    virtual bool read(uint16_t* bands, uint32_t* timestamp) = 0;
+    virtual const char* name() = 0;
+};
+
+
+
+
+// the MSGEQ7 chip, with USE_AUDIO_TIMER its sampler only runs
+// while it's the source, the fft sampler uses the same ADC
+class MSGEQ7Source : public AudioSource {
+  public:
+    void begin()
+    {
+#ifdef USE_AUDIO_TIMER
+      if (!_started)
+        startAudioSampler();
+      _started = true;
+#endif
+    }
+
+    void end()
+    {
+#ifdef USE_AUDIO_TIMER
+      if (_started)
+        stopAudioSampler();
+      _started = false;
+#endif
+    }
+
+    bool read(uint16_t* bands, uint32_t* timestamp)
+    {
+      readMSGEQ7(bands);
+      *timestamp = audioTimestamp;
+      return true;
+    }
+
+    const char* name() { return "msgeq7"; }
+
+  private:
+    bool _started = false;
+};
+
+
+
+
+// sim data for 8 seconds then 2 seconds of silence
+class SimAudioSource : public AudioSource {
+  public:
+    bool read(uint16_t* bands, uint32_t* timestamp)
+    {
+      bool silent = millis() % 10000 < 2000;
+
+      for (uint8_t band = 0; band < EQ_BANDS7; band++)
+        bands[band] = silent ? 0 : random(100, 700);
+
+      *timestamp = micros();
+      return true;
+    }
+
+    const char* name() { return "sim"; }
+};
+
+
+
+
+// recorded band frames, advances one frame per read and loops
+class ReplaySource : public AudioSource {
+  public:
+    ReplaySource(const uint16_t (*frames)[EQ_BANDS7], uint16_t numFrames)
+    {
+      _frames = frames;
+      _numFrames = numFrames;
+      _frame = 0;
+    }
+
+    void rewind()
+    {
+      _frame = 0;
+    }
+
+    bool read(uint16_t* bands, uint32_t* timestamp)
+    {
+      for (uint8_t band = 0; band < EQ_BANDS7; band++)
+        bands[band] = _frames[_frame][band];
+
+      _frame++;
+      if (_frame >= _numFrames)
+        _frame = 0;
+
+      *timestamp = micros();
+      return true;
+    }
+
+    const char* name() { return "replay"; }
+
+  private:
+    const uint16_t (*_frames)[EQ_BANDS7];
+    uint16_t _numFrames;
+    uint16_t _frame;
+};
+
+
+
+
+#ifdef USE_SD_AUDIO
+
+#define WAV_FRAME_RATE      60      // audio frames per second of the file
+#define WAV_BLOCK_SIZE      256     // samples read from the card at a time
+#define WAV_FILTER_Q        1.4     // bandwidth of each band filter
+#define WAV_LEVEL_SF        2.0     // full scale sine -> 2x MAX_AUDIO
+#define WAV_BACKGROUND      60      // offset to look like the MSGEQ7
+
+
+// the MSGEQ7 band centers
+const float wavBandFreq[EQ_BANDS7] = {63, 160, 400, 1000, 2500, 6250, 16000};
+
+
+// plays a WAV file a fixed number of samples per read, so the
+// result only depends on the file and not on the frame rate
+class WavSource : public AudioSource {
+  public:
+    WavSource(const char* fileName)
+    {
+      _fileName = fileName;
+      _ok = false;
+    }
+
+
+    void begin()
+    {
+      _ok = false;
+
+      if (!SD.begin(BUILTIN_SDCARD))
+      {
+        Serial.println("wav: no SD card");
+        return;
+      }
+
+      _file = SD.open(_fileName, FILE_READ);
+      if (!_file || !readHeader())
+      {
+        Serial.print("wav: can't play "); Serial.println(_fileName);
+        return;
+      }
+
+      setupFilters();
+      rewind();
+      _ok = true;
+    }
+
+
+    void rewind()
+    {
+      if (_file)
+        _file.seek(_dataStart);
+      _dataPos = 0;
+
+      for (uint8_t band = 0; band < EQ_BANDS7; band++)
+        _z1[band] = _z2[band] = 0;
+    }
+
+
+    bool read(uint16_t* bands, uint32_t* timestamp)
+    {
+      *timestamp = micros();
+
+      if (!_ok)
+      {
+        for (uint8_t band = 0; band < EQ_BANDS7; band++)
+          bands[band] = 0;
+        return false;
+      }
+
+      float peak[EQ_BANDS7] = {0};
+      uint32_t remaining = _sampleRate / WAV_FRAME_RATE;
+
+      while (remaining > 0)
+      {
+        uint16_t count = readBlock(min(remaining, (uint32_t)WAV_BLOCK_SIZE));
+        if (count == 0)
+          break;
+
+        for (uint16_t i = 0; i < count; i++)
+        {
+          float x = _block[i];
+
+          // transposed direct form II biquad per band, keep the peak
+          for (uint8_t band = 0; band < EQ_BANDS7; band++)
+          {
+            float y = _b0[band] * x + _z1[band];
+            _z1[band] = _b1[band] * x - _a1[band] * y + _z2[band];
+            _z2[band] = _b2[band] * x - _a2[band] * y;
+
+            if (y < 0) y = -y;
+            if (y > peak[band]) peak[band] = y;
+          }
+        }
+        remaining -= count;
+      }
+
+      for (uint8_t band = 0; band < EQ_BANDS7; band++)
+      {
+        float level = peak[band] * (MAX_AUDIO * WAV_LEVEL_SF / 32768.0) + WAV_BACKGROUND;
+        bands[band] = constrain(level, 0, MAX_AUDIO);
+      }
+
+      return true;
+    }
+
+
+    const char* name() { return "wav"; }
+
+
+  private:
+    const char* _fileName;
+    File _file;
+    bool _ok;
+    uint32_t _sampleRate;
+    uint16_t _channels;
+    uint32_t _dataStart;
+    uint32_t _dataSize;
+    uint32_t _dataPos;
+    float _block[WAV_BLOCK_SIZE];
+
+    // biquad coefficients & state for each band
+    float _b0[EQ_BANDS7], _b1[EQ_BANDS7], _b2[EQ_BANDS7], _a1[EQ_BANDS7], _a2[EQ_BANDS7];
+    float _z1[EQ_BANDS7], _z2[EQ_BANDS7];
+
+
+    // the header reads are all false if the file ends first
+    bool readBytes(void* buffer, uint16_t count)
+    {
+      return _file.read(buffer, count) == count;
+    }
+
+
+    bool read32(uint32_t& value)
+    {
+      uint8_t b[4];
+      if (!readBytes(b, 4))
+        return false;
+      value = b[0] | (b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+      return true;
+    }
+
+
+    bool read16(uint16_t& value)
+    {
+      uint8_t b[2];
+      if (!readBytes(b, 2))
+        return false;
+      value = b[0] | (b[1] << 8);
+      return true;
+    }
+
+
+    // find the fmt & data chunks, only 16-bit PCM is supported.
+    // A short or truncated file fails here so begin() gives up
+    bool readHeader()
+    {
+      char id[4];
+      uint32_t size;
+
+      if (!readBytes(id, 4) || strncmp(id, "RIFF", 4) != 0 || !read32(size) ||
+          !readBytes(id, 4) || strncmp(id, "WAVE", 4) != 0)
+        return false;
+
+      bool haveFormat = false;
+      while (readBytes(id, 4) && read32(size))
+      {
+        uint32_t next = _file.position() + size + (size & 1);
+
+        if (strncmp(id, "fmt ", 4) == 0)
+        {
+          uint16_t format, blockAlign, bits;
+          uint32_t byteRate;
+
+          if (!read16(format) || !read16(_channels) || !read32(_sampleRate) ||
+              !read32(byteRate) || !read16(blockAlign) || !read16(bits))
+            return false;
+
+          if (format != 1 || bits != 16 || _channels < 1 || _channels > 2 || _sampleRate == 0)
+            return false;
+          haveFormat = true;
+        }
+        else if (strncmp(id, "data", 4) == 0)
+        {
+          _dataStart = _file.position();
+          _dataSize = size;
+          return haveFormat;
+        }
+
+        _file.seek(next);
+      }
+
+      return false;
+    }
+
+
+    // RBJ band pass filters, 0 dB peak gain
+    void setupFilters()
+    {
+      for (uint8_t band = 0; band < EQ_BANDS7; band++)
+      {
+        float w0 = TWO_PI * wavBandFreq[band] / _sampleRate;
+        float alpha = sin(w0) / (2.0 * WAV_FILTER_Q);
+        float a0 = 1.0 + alpha;
+
+        _b0[band] = alpha / a0;
+        _b1[band] = 0;
+        _b2[band] = -alpha / a0;
+        _a1[band] = -2.0 * cos(w0) / a0;
+        _a2[band] = (1.0 - alpha) / a0;
+      }
+    }
+
+
+    // read up to count mono samples, looping at the end of the file
+    uint16_t readBlock(uint16_t count)
+    {
+      int16_t raw[2];
+      uint16_t frameBytes = _channels * 2;
+
+      for (uint16_t i = 0; i < count; i++)
+      {
+        if (_dataPos + frameBytes > _dataSize)
+        {
+          _file.seek(_dataStart);
+          _dataPos = 0;
+        }
+
+        if (_file.read(raw, frameBytes) != frameBytes)
+          return i;
+        _dataPos += frameBytes;
+
+        _block[i] = (_channels == 2) ? (raw[0] + raw[1]) * 0.5 : raw[0];
+      }
+
+      return count;
+    }
+};
+
+#endif
+
+
+
+#ifdef USE_FFT_AUDIO
+#include "fftAudio.h"
+#endif
+
+
+
+// available sources, selected from serial
+#ifdef USE_FFT_AUDIO
+FftSource fftSource;
+#endif
+MSGEQ7Source msgeq7Source;
+SimAudioSource simSource;
+ReplaySource replaySource(audioTrace, AUDIO_TRACE_FRAMES);
+#ifdef USE_SD_AUDIO
+WavSource wavSource(WAV_FILE_NAME);
+#endif
+
+AudioSource* audioSources[] = {
+#ifdef USE_FFT_AUDIO
+  &fftSource,
+#endif
+  &msgeq7Source,
+  &simSource,
+  &replaySource,
+#ifdef USE_SD_AUDIO
+  &wavSource,
+#endif
+};
+
+const uint8_t numAudioSources = sizeof(audioSources) / sizeof(audioSources[0]);
+AudioSource* audioSource = audioSources[0];
+
+
+
+
+void selectAudioSource(uint8_t index)
+{
+  if (index >= numAudioSources)
+    index = 0;
+
+  // stop the outgoing source's sampling first
+  if (audioSources[index] != audioSource)
+    audioSource->end();
+
+  audioSource = audioSources[index];
+  audioSource->begin();
+  audioSource->rewind();
+
+  Serial.print("audio source: ");
+  Serial.println(audioSource->name());
+}
+
+
+
+
+// simAudio overrides the selected source
+AudioSource* currentAudioSource()
+{
+  return simAudio ? &simSource : audioSource;
+}
+
+
+
+#ifdef USE_FFT_AUDIO
+// the fft bands are only fresh while it's the source
+bool fftActive()
+{
+  return currentAudioSource() == &fftSource;
+}
+#endif
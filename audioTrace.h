@@ -0,0 +1,264 @@
+/*************************************************************
+
+   audioTrace.h - a short band trace for repeatable runs
+
+   240 frames (about 4 seconds at 60 fps) of raw 10-bit MSGEQ7
+   values, 7 bands per frame. This one is synthetic: a 120 BPM
+   kick / snare / hi-hat loop over a slow melody sweep, with the
+   usual ~60 count background offset. Replace it with a recorded
+   trace by turning on audio recording from serial ('R') and
+   pasting the printed rows here.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#define AUDIO_TRACE_FRAMES  240
+
+
+const uint16_t audioTrace[AUDIO_TRACE_FRAMES][EQ_BANDS7] PROGMEM = {
+  { 795,  650,  174,  157,  315,  426,  307},
+  { 725,  578,  179,  150,  229,  310,  250},
+  { 630,  508,  184,  136,  141,  207,  140},
+  { 535,  446,  206,  142,   46,  104,   73},
+  { 446,  415,  202,  144,   65,   98,   85},
+  { 358,  344,  220,  131,   46,   88,   56},
+  { 289,  295,  212,  123,   58,   86,   72},
+  { 189,  227,  223,  126,   71,  104,   60},
+  { 104,  168,  238,  124,  301,  446,  308},
+  { 120,  176,  228,  117,  212,  338,  227},
+  { 120,  178,  249,  108,  152,  214,  152},
+  { 124,  189,  252,  101,   54,   95,   80},
+  { 113,  186,  267,   93,   47,  107,   64},
+  { 126,  182,  276,   92,   68,  104,   64},
+  { 130,  172,  256,   94,   58,   96,   79},
+  { 123,  177,  537,  439,  258,   93,   85},
+  { 135,  177,  495,  379,  479,  468,  333},
+  { 142,  188,  443,  322,  356,  346,  236},
+  { 135,  205,  410,  241,  254,  213,  168},
+  { 126,  197,  380,  198,  113,   96,   78},
+  { 141,  193,  339,  134,   99,  122,   69},
+  { 129,  208,  293,   83,   66,  108,   55},
+  { 151,  202,  295,   58,   64,  100,   70},
+  { 123,  196,  310,   60,   49,  121,   62},
+  { 135,  203,  317,   76,  310,  450,  310},
+  { 137,  204,  307,   56,  239,  336,  247},
+  { 137,  220,  309,   55,  150,  229,  149},
+  { 145,  222,  305,   76,   52,  103,   57},
+  { 129,  198,  301,   66,   52,   99,   70},
+  { 150,  212,  299,   53,   54,   99,   59},
+  { 838,  712,  306,   64,   63,  110,   85},
+  { 741,  654,  321,   61,   75,  118,   75},
+  { 670,  592,  295,   59,  323,  476,  329},
+  { 592,  533,  314,   71,  228,  345,  233},
+  { 486,  455,  295,   62,  148,  228,  139},
+  { 392,  381,  296,   62,   50,  102,   65},
+  { 317,  317,  291,   49,   63,  102,   72},
+  { 212,  282,  297,   70,   45,  100,   82},
+  { 127,  207,  296,   57,   65,  105,   85},
+  { 131,  205,  292,   70,   48,  100,   82},
+  { 134,  198,  293,   73,  304,  448,  309},
+  { 121,  205,  284,   84,  219,  344,  247},
+  { 139,  185,  287,   64,  134,  241,  168},
+  { 132,  189,  271,   89,   62,  123,   55},
+  { 138,  191,  271,   90,   72,   95,   77},
+  { 140,  181,  524,  435,  274,   97,   66},
+  { 135,  177,  478,  386,  235,  107,   65},
+  { 130,  174,  434,  340,  203,  114,   82},
+  { 114,  189,  375,  287,  407,  462,  330},
+  { 113,  166,  337,  222,  289,  344,  221},
+  { 105,  182,  282,  168,  169,  210,  160},
+  { 122,  184,  237,  113,   70,  115,   78},
+  { 112,  180,  231,  106,   52,   88,   62},
+  { 114,  152,  224,  115,   60,  102,   83},
+  { 116,  169,  208,  129,   74,  102,   66},
+  { 120,  159,  204,  145,   66,   84,   84},
+  { 105,  160,  217,  148,  301,  445,  333},
+  {  96,  144,  214,  149,  221,  314,  246},
+  { 119,  150,  195,  148,  140,  217,  168},
+  {  89,  146,  181,  144,   49,   76,   59},
+  { 803,  648,  184,  169,   65,   79,   74},
+  { 721,  572,  178,  171,   74,   84,   59},
+  { 622,  504,  160,  155,   45,   97,   78},
+  { 536,  423,  166,  183,   74,   75,   68},
+  { 453,  360,  170,  192,  301,  419,  313},
+  { 343,  297,  153,  177,  235,  319,  231},
+  { 255,  238,  144,  201,  132,  184,  167},
+  { 181,  166,  153,  194,   66,   84,   81},
+  {  96,  105,  132,  211,   74,   92,   71},
+  {  70,  102,  117,  206,   61,   63,   82},
+  {  79,  106,  112,  213,   45,   86,   80},
+  {  67,   84,  105,  214,   64,   84,   58},
+  {  78,   76,  106,  224,  311,  426,  322},
+  {  74,   97,  115,  210,  239,  309,  222},
+  {  65,   75,   94,  212,  152,  177,  154},
+  {  70,   83,  331,  589,  273,   86,   57},
+  {  69,   74,  304,  526,  230,   72,   61},
+  {  75,   69,  253,  472,  195,   80,   70},
+  {  68,   89,  200,  422,  161,   82,   83},
+  {  81,   86,  156,  374,  128,   82,   85},
+  {  56,   81,  117,  293,  341,  406,  317},
+  {  63,   63,   60,  255,  218,  299,  223},
+  {  54,   72,   64,  261,  131,  196,  162},
+  {  51,   79,   75,  258,   66,   62,   59},
+  {  54,   76,   55,  270,   59,   58,   78},
+  {  76,   50,   61,  269,   60,   55,   76},
+  {  71,   53,   52,  264,   58,   66,   67},
+  {  55,   58,   52,  254,   55,   52,   78},
+  {  56,   45,   55,  261,  309,  414,  327},
+  {  45,   57,   55,  260,  230,  292,  237},
+  { 775,  547,   48,  274,  153,  173,  166},
+  { 660,  484,   53,  252,   46,   78,   79},
+  { 575,  428,   69,  248,   71,   63,   82},
+  { 511,  379,   72,  273,   53,   62,   59},
+  { 412,  325,   63,  260,   60,   72,   65},
+  { 310,  243,   50,  266,   67,   55,   68},
+  { 249,  175,   59,  270,  295,  421,  307},
+  { 160,  120,   55,  257,  238,  291,  223},
+  {  56,   78,   58,  250,  128,  178,  155},
+  {  62,   82,   87,  242,   64,   56,   56},
+  {  66,   77,   68,  261,   48,   58,   63},
+  {  52,   62,   71,  257,   54,   74,   64},
+  {  68,   83,   74,  234,   59,   70,   76},
+  {  58,   69,   83,  247,   45,   63,   56},
+  {  55,   64,  100,  235,  312,  412,  321},
+  {  71,   73,  360,  579,  414,  311,  247},
+  {  78,   82,  315,  518,  312,  200,  166},
+  {  71,   88,  267,  463,  184,   66,   65},
+  {  67,  101,  249,  400,  168,   80,   59},
+  {  75,   90,  186,  342,  115,   61,   57},
+  {  85,  105,  177,  261,   91,   67,   56},
+  {  68,  106,  139,  202,   72,   79,   76},
+  {  77,  108,  126,  207,  304,  415,  319},
+  {  75,   98,  133,  194,  211,  307,  232},
+  { 102,  106,  148,  185,  135,  184,  168},
+  { 102,  109,  143,  181,   50,   68,   65},
+  {  88,  106,  159,  173,   61,   89,   61},
+  {  85,  124,  174,  160,   47,   79,   81},
+  {  82,  116,  168,  173,   46,   84,   55},
+  {  91,  125,  183,  157,   47,   91,   85},
+  { 801,  646,  193,  149,  316,  453,  327},
+  { 724,  589,  195,  151,  235,  319,  244},
+  { 629,  506,  192,  157,  147,  214,  142},
+  { 529,  470,  215,  151,   73,   94,   75},
+  { 456,  408,  217,  149,   61,   84,   84},
+  { 373,  350,  218,  137,   71,  107,   80},
+  { 272,  294,  229,  132,   70,  110,   77},
+  { 207,  239,  236,  129,   52,   85,   55},
+  { 102,  154,  240,  115,  325,  438,  317},
+  { 129,  168,  243,  100,  231,  319,  241},
+  { 121,  178,  239,  110,  136,  204,  152},
+  { 131,  162,  261,  119,   61,  116,   72},
+  { 110,  185,  259,   88,   68,  112,   70},
+  { 118,  192,  250,  109,   53,   97,   78},
+  { 135,  176,  260,  101,   65,  105,   70},
+  { 140,  185,  510,  439,  274,  113,   64},
+  { 138,  176,  490,  382,  481,  449,  307},
+  { 135,  182,  443,  308,  365,  350,  243},
+  { 126,  199,  414,  243,  228,  226,  139},
+  { 133,  190,  379,  180,  133,  101,   76},
+  { 134,  193,  341,  132,   87,  110,   69},
+  { 134,  210,  284,   83,   62,  103,   64},
+  { 123,  217,  299,   53,   54,  111,   57},
+  { 148,  206,  316,   65,   53,  110,   61},
+  { 152,  221,  317,   55,  297,  466,  307},
+  { 127,  215,  306,   56,  241,  343,  225},
+  { 143,  219,  312,   63,  136,  244,  141},
+  { 146,  205,  300,   61,   73,  127,   70},
+  { 136,  194,  299,   45,   75,  114,   76},
+  { 138,  206,  303,   68,   49,  112,   66},
+  { 837,  705,  298,   71,   55,  100,   65},
+  { 761,  642,  320,   57,   48,  129,   84},
+  { 655,  591,  294,   73,  318,  458,  313},
+  { 573,  508,  305,   58,  238,  351,  223},
+  { 485,  472,  305,   71,  136,  243,  139},
+  { 394,  382,  291,   74,   66,  108,   75},
+  { 327,  320,  295,   57,   58,  114,   65},
+  { 215,  276,  297,   76,   75,  111,   83},
+  { 121,  213,  308,   73,   57,  126,   83},
+  { 150,  203,  298,   61,   68,   99,   56},
+  { 148,  207,  291,   72,  314,  470,  309},
+  { 138,  209,  283,   76,  212,  358,  250},
+  { 134,  184,  276,   79,  141,  221,  147},
+  { 125,  186,  290,   90,   65,  102,   67},
+  { 134,  182,  271,   85,   62,  114,   67},
+  { 116,  178,  528,  429,  247,   98,   71},
+  { 139,  195,  476,  386,  218,  105,   84},
+  { 120,  191,  429,  328,  182,  107,   61},
+  { 115,  166,  373,  271,  412,  441,  315},
+  { 113,  171,  329,  232,  296,  327,  249},
+  { 105,  180,  301,  166,  173,  217,  161},
+  { 119,  160,  238,  107,   55,  110,   56},
+  { 116,  158,  238,  134,   56,   89,   76},
+  { 115,  162,  234,  134,   72,  110,   61},
+  {  99,  151,  236,  121,   57,   94,   75},
+  { 109,  152,  232,  128,   72,  107,   82},
+  { 123,  135,  199,  125,  308,  452,  329},
+  { 119,  156,  204,  159,  229,  327,  221},
+  {  91,  139,  212,  163,  157,  220,  154},
+  { 114,  137,  190,  146,   70,   79,   62},
+  { 789,  624,  186,  165,   48,  105,   81},
+  { 718,  575,  183,  177,   69,  101,   69},
+  { 607,  504,  180,  156,   45,   97,   59},
+  { 523,  438,  179,  161,   65,   93,   64},
+  { 456,  358,  164,  173,  311,  439,  318},
+  { 359,  312,  140,  173,  213,  310,  237},
+  { 277,  239,  137,  187,  136,  190,  163},
+  { 177,  155,  125,  197,   54,   80,   63},
+  {  98,   99,  139,  211,   73,   71,   70},
+  {  82,   92,  130,  197,   45,   93,   68},
+  {  86,  102,  116,  196,   45,   68,   70},
+  {  91,  100,  121,  212,   47,   69,   62},
+  {  82,   88,  125,  214,  302,  425,  306},
+  {  81,   82,  113,  220,  222,  313,  233},
+  {  64,   69,  111,  220,  151,  201,  154},
+  {  58,   72,  346,  571,  254,   81,   81},
+  {  61,   71,  299,  517,  219,   80,   83},
+  {  62,   64,  269,  475,  193,   74,   60},
+  {  80,   66,  208,  413,  174,   75,   56},
+  {  81,   76,  152,  374,  123,   55,   61},
+  {  50,   74,  107,  302,  329,  425,  306},
+  {  54,   65,   72,  262,  233,  314,  231},
+  {  71,   54,   57,  265,  133,  178,  144},
+  {  52,   69,   82,  254,   68,   65,   56},
+  {  55,   69,   74,  252,   71,   62,   65},
+  {  60,   52,   52,  241,   47,   58,   57},
+  {  56,   59,   77,  270,   48,   67,   85},
+  {  69,   51,   58,  254,   69,   76,   64},
+  {  71,   70,   58,  246,  296,  422,  320},
+  {  51,   56,   62,  273,  225,  289,  231},
+  { 756,  568,   73,  260,  128,  186,  151},
+  { 664,  507,   65,  268,   57,   51,   67},
+  { 571,  434,   47,  269,   74,   51,   63},
+  { 488,  381,   48,  271,   64,   60,   66},
+  { 403,  306,   77,  272,   64,   51,   63},
+  { 331,  257,   71,  251,   74,   58,   64},
+  { 221,  196,   75,  259,  324,  426,  325},
+  { 165,  142,   55,  238,  237,  291,  224},
+  {  63,   73,   85,  250,  158,  192,  150},
+  {  74,   61,   87,  247,   71,   67,   59},
+  {  79,   70,   66,  231,   70,   82,   78},
+  {  60,   83,   87,  252,   49,   73,   62},
+  {  62,   86,   78,  239,   56,   79,   80},
+  {  72,   63,   88,  228,   57,   79,   60},
+  {  62,   77,   79,  239,  296,  421,  322},
+  {  73,   76,  336,  578,  439,  293,  223},
+  {  66,   88,  296,  509,  298,  187,  153},
+  {  81,   86,  263,  448,  182,   72,   69},
+  {  80,  103,  242,  385,  168,   77,   82},
+  {  87,  100,  209,  319,  135,   87,   64},
+  {  74,   90,  167,  261,   89,   70,   78},
+  {  74,   91,  127,  197,   50,   70,   62},
+  {  72,   98,  147,  214,  313,  420,  315},
+  {  72,  105,  133,  187,  227,  315,  228},
+  {  92,  121,  134,  195,  142,  184,  141},
+  {  74,  115,  165,  196,   52,   94,   69},
+  { 105,  115,  145,  193,   54,   76,   58},
+  {  79,  114,  169,  186,   63,   77,   84},
+  {  82,  123,  172,  182,   50,   86,   74},
+  {  90,  140,  187,  171,   75,   73,   58},
+};
@@ -64,7 +64,7 @@
 
 
 // hardware.h must be included first, sets display specific settings
-#include "hardware.h"
+#include "Hardware.h"
 
 
 
@@ -102,7 +102,7 @@ uint8_t printLevel  = 1;             // debug print leveluint8_t
 uint8_t pattern     = 1;             // * set starting pattern
 uint8_t persistance = 176;           // * how much to dim pixels stars
 uint16_t dmxAddress = DMX_ADDRESS;   // * dmx address
-uint32_t delayVal   = DELAY_VAL;     // * overall display update rate
+uint32_t delayVal   = DELAY_VAL;     // * mS added to every pattern's frame time
 
 
 // global vars
@@ -161,9 +161,12 @@ const uint32_t kNumLEDs = kMatrixWidth * kMatrixHeight;
 
 
 // include modules
+#include "frameClock.h"
+#include "quality.h"
 #include "readAudio.h"
-#include "audioPatterns.h"
+#include "AudioPatterns.h"
 AudioPatterns audioPatterns;
+#include "benchmark.h"
 
 
 #ifdef USE_SERIAL
@@ -179,6 +182,8 @@ AudioPatterns audioPatterns;
 #include "dmx.h"
 #endif
 
+#include "frameScheduler.h"
+
 
 
 
@@ -214,10 +219,11 @@ void setup()
   kMatrixCenterY = kScreenHeight / 2;
 
   // clear display by filling it black
-  backgroundLayer.fillScreen(BLACK);
+  canvas.begin();
+  canvas.fillScreen(BLACK);
 
   // send led display buffer to matrix - this is what actually updates the leds
-  backgroundLayer.swapBuffers();
+  canvas.present();
 
   // init patterns
   audioPatterns.init();
@@ -256,15 +262,7 @@ void setup()
 
 void loop()
 {
-  // check serial port for data & handle
-#ifdef USE_SERIAL
-  checkSerial();
-#endif
-
-  // check for dmx change
-#ifdef USE_DMX
-  checkDMX();
-#endif
+  beginFrame();
 
   // update audio pattern
   audioPatterns.update();
@@ -272,14 +270,6 @@ void loop()
   // print the frames per second for debug
   if (showFPS) matrix.countFPS();
 
-  // check for pending ir commands
-#ifdef USE_IR_REMOTE
-  checkIRRemote();
-#endif
-
-  // slow things down a bit
-  delay(delayVal);
-
   // periodically check if eeprom data needs to be saved
   if (ticks % 5000 < 5)
   {
@@ -289,6 +279,9 @@ void loop()
 
   // increment loop counter
   ticks += 1;
+
+  // serial, dmx & ir are handled while waiting for the next frame
+  endFrame();
 }
 
 
@@ -371,10 +364,12 @@ void showSettings()
   Serial.print("screen hieght: "); Serial.println(kScreenHeight);
   Serial.print("center X     : "); Serial.println(kMatrixCenterX);
   Serial.print("center Y     : "); Serial.println(kMatrixCenterY);
-  Serial.print("audio gain   : "); Serial.println(gain);
+  Serial.print("audio gain   : "); Serial.println(gainValue());
   Serial.print("simAudio     : "); simAudio ? Serial.println("Enabled") : Serial.println("Disabled");
+  Serial.print("audio source : "); Serial.println(currentAudioSource()->name());
   Serial.print("testMode     : "); testMode ? Serial.println("Enabled") : Serial.println("Disabled");
   Serial.print("delayVal     : "); Serial.println(delayVal);
+  printFrameStats();
   Serial.print("printLevel   : "); Serial.println(printLevel);
   Serial.print("num Patterns : "); Serial.println(numPatterns);
   Serial.print("curr Pattern : "); Serial.print(pattern); Serial.print(" = "); Serial.println(patternName[pattern]);
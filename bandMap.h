@@ -0,0 +1,170 @@
+/*************************************************************
+
+   bandMap.h - maps audio bands onto screen columns
+
+   Each BandMap is built once for the screen width (from
+   AudioPatterns::init(), so again after a rotation) and works
+   out, for every column, which source bands it sits between and
+   how far along. Once per frame update() fills in the level and
+   pixel height of every column, so patterns just index
+   map.height[x] instead of dividing in their inner loops.
+
+   Columns are spread over the whole width, so no columns are
+   left dark when the width isn't a multiple of the band count
+   (192 / 7 used to leave the last 3 columns unused).
+
+   BAND_STEP   - each column takes the level of its band (bars)
+   BAND_SMOOTH - levels are interpolated between band centers
+
+   Maps in use:
+   bandMap7     - peaks[] as 7 bars (analyzer7)
+   bandMap16    - audio16[] as 16 bars (analyzer16)
+   columnMap    - the 7 bands interpolated across every column
+   fftColumnMap - the FFT_BANDS fft bands interpolated, with
+                  USE_FFT_AUDIO. While the fft is the source the
+                  analyzers draw a column each from it instead of
+                  the bars, and spectrumMap() returns it instead
+                  of columnMap
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+// largest screen width, either way round after a rotation
+const uint16_t kMaxScreenWidth = (kMatrixWidth > kMatrixHeight) ? kMatrixWidth : kMatrixHeight;
+
+enum {
+  BAND_STEP,
+  BAND_SMOOTH
+};
+
+
+class BandMap;
+
+
+// prototypes
+void buildBandMaps(uint16_t width);
+void updateBandMaps();
+BandMap& spectrumMap();
+
+
+
+class BandMap {
+  public:
+    uint8_t  band[kMaxScreenWidth];     // nearest source band, for colors
+    uint16_t level[kMaxScreenWidth];    // audio level of each column
+    uint16_t height[kMaxScreenWidth];   // level in pixels
+    uint16_t width = 0;
+    uint8_t  numBands = 0;
+
+
+    void build(uint16_t screenWidth, uint8_t bands, uint8_t mode)
+    {
+      width = min(screenWidth, kMaxScreenWidth);
+      numBands = bands;
+
+      for (uint16_t x = 0; x < width; x++)
+      {
+        // column center in band units, 8 fractional bits
+        int32_t pos = ((2 * x + 1) * (bands << 8)) / (2 * width);
+        band[x] = pos >> 8;
+
+        if (mode == BAND_STEP || bands < 2)
+        {
+          _lower[x] = band[x];
+          _frac[x] = 0;
+        }
+        else
+        {
+          // measured from the band centers, clamped at the ends
+          pos = constrain(pos - 128, 0, (bands - 1) << 8);
+          _lower[x] = pos >> 8;
+          _frac[x] = pos & 0xFF;
+        }
+
+        level[x] = 0;
+        height[x] = 0;
+      }
+    }
+
+
+    template <typename T>
+    void update(const T* source, uint16_t audioSF)
+    {
+      for (uint16_t x = 0; x < width; x++)
+      {
+        uint8_t lower = _lower[x];
+        uint16_t frac = _frac[x];
+        int32_t value = (int32_t)source[lower];
+
+        if (frac > 0)
+          value = ((256 - frac) * value + frac * (int32_t)source[lower + 1]) >> 8;
+
+        if (value < 0)
+          value = 0;
+
+        level[x] = value;
+        height[x] = value / audioSF;
+      }
+    }
+
+
+  private:
+    uint8_t _lower[kMaxScreenWidth];    // band to the left of the column
+    uint8_t _frac[kMaxScreenWidth];     // how far to the next band, / 256
+};
+
+
+
+BandMap bandMap7;
+BandMap bandMap16;
+BandMap columnMap;
+#ifdef USE_FFT_AUDIO
+BandMap fftColumnMap;
+#endif
+
+
+
+
+// called when the pattern or screen size changes
+void buildBandMaps(uint16_t width)
+{
+  bandMap7.build(width, EQ_BANDS7, BAND_STEP);
+  bandMap16.build(width, EQ_BANDS16, BAND_STEP);
+  columnMap.build(width, EQ_BANDS7, BAND_SMOOTH);
+#ifdef USE_FFT_AUDIO
+  fftColumnMap.build(width, FFT_BANDS, BAND_SMOOTH);
+#endif
+}
+
+
+
+
+// once per frame, after the levels are scaled
+void updateBandMaps()
+{
+  bandMap7.update(peaks, yAudioSF);
+  bandMap16.update(audio16, yAudioSF);
+  columnMap.update(usePeaks ? peaks : audio, yAudioSF);
+#ifdef USE_FFT_AUDIO
+  if (fftActive())
+    fftColumnMap.update(usePeaks ? fftPeaks : fftAudio, yAudioSF);
+#endif
+}
+
+
+
+
+// the column levels with the most detail there are
+BandMap& spectrumMap()
+{
+#ifdef USE_FFT_AUDIO
+  if (fftActive())
+    return fftColumnMap;
+#endif
+  return columnMap;
+}
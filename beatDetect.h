@@ -0,0 +1,238 @@
+/*************************************************************
+
+   beatDetect.h - onset detector and tempo tracker
+
+   Runs once per frame after readAudio() has the new levels.
+
+   Onsets: spectral flux (sum of the increases in each of the
+   7 bands since the last frame) compared against a running
+   mean + deviation of the flux, with a short hold-off so one
+   hit isn't counted twice.
+
+   Tempo: every onset votes for the intervals back to the last
+   few onsets (nearest weighted most), folded into
+   BEAT_MIN_BPM - BEAT_MAX_BPM, in a decaying histogram. The strongest bin is the tempo.
+
+   Phase: a beat clock runs at the tracked tempo and is pulled
+   toward onsets that land near a predicted beat. Every 4th
+   beat is flagged as a downbeat (there's no bar detection, so
+   it's only the start of a group of 4 tracked beats).
+
+   Results for patterns:
+   onset      - true on a frame with a detected onset
+   beat       - true on the frame the beat clock ticks
+   downbeat   - true on every 4th beat
+   beatPhase  - 0 - 255 position within the current beat
+   bpm        - tracked tempo, 0 until there's enough music
+
+   Times are frameMillis (frameClock.h), not millis(). All
+   integer math, a few uS per frame.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#define BEAT_MIN_BPM        60
+#define BEAT_MAX_BPM        180
+#define BEAT_BPM_BIN        2         // histogram resolution in BPM
+#define BEAT_HISTORY        6         // onsets kept for intervals
+#define BEAT_HOLDOFF_MS     100       // min time between onsets
+#define BEAT_MIN_FLUX       60        // ignore tiny changes
+#define BEAT_THRESHOLD_Q4   24        // mean + 1.5 x deviation (Q4)
+#define BEAT_MIN_VOTES      64        // histogram score needed to lock
+#define BEAT_BINS           ((BEAT_MAX_BPM - BEAT_MIN_BPM) / BEAT_BPM_BIN + 1)
+
+
+// prototypes
+void detectBeat();
+void resetBeat();
+void voteTempo(uint32_t interval, uint8_t weight);
+
+
+// results
+bool     onset = false;
+bool     beat = false;
+bool     downbeat = false;
+uint8_t  beatPhase = 0;
+uint16_t bpm = 0;
+uint32_t beatCount = 0;
+
+
+// detector state
+int32_t  lastBandLevel[EQ_BANDS7];
+int32_t  fluxMean = 0;                    // running mean, Q4
+int32_t  fluxDev = 0;                     // running mean deviation, Q4
+uint32_t onsetTimes[BEAT_HISTORY];
+uint8_t  onsetIndex = 0;
+uint16_t tempoVotes[BEAT_BINS];
+uint32_t lastBeatTime = 0;
+uint32_t beatPeriod = 0;                  // mS, 0 = no tempo yet
+
+
+
+
+void resetBeat()
+{
+  for (uint8_t band = 0; band < EQ_BANDS7; band++)
+    lastBandLevel[band] = 0;
+
+  for (uint8_t i = 0; i < BEAT_HISTORY; i++)
+    onsetTimes[i] = 0;
+
+  for (uint8_t i = 0; i < BEAT_BINS; i++)
+    tempoVotes[i] = 0;
+
+  fluxMean = 0;
+  fluxDev = 0;
+  bpm = 0;
+  beatPeriod = 0;
+  beatCount = 0;
+  beatPhase = 0;
+  onset = beat = downbeat = false;
+}
+
+
+
+
+void detectBeat()
+{
+  // the frame clock, so fixedFrameDt runs give the same beats
+  uint32_t now = frameMillis;
+
+  // spectral flux, only increases count
+  int32_t flux = 0;
+  for (uint8_t band = 0; band < EQ_BANDS7; band++)
+  {
+    int32_t level = audio[band];
+    if (level > lastBandLevel[band])
+      flux += level - lastBandLevel[band];
+    lastBandLevel[band] = level;
+  }
+
+  // adaptive threshold from the running mean & deviation (1/16 per frame)
+  int32_t fluxQ4 = flux << 4;
+  int32_t threshold = fluxMean + ((fluxDev * BEAT_THRESHOLD_Q4) >> 4);
+
+  uint32_t lastOnset = onsetTimes[(onsetIndex + BEAT_HISTORY - 1) % BEAT_HISTORY];
+  onset = flux > BEAT_MIN_FLUX && fluxQ4 > threshold && now - lastOnset > BEAT_HOLDOFF_MS;
+
+  fluxDev += (abs(fluxQ4 - fluxMean) - fluxDev) >> 4;
+  fluxMean += (fluxQ4 - fluxMean) >> 4;
+
+  if (onset)
+  {
+    // vote for the intervals back to the previous onsets,
+    // the nearer ones count more
+    for (uint8_t back = 0; back < BEAT_HISTORY; back++)
+    {
+      uint32_t time = onsetTimes[(onsetIndex + BEAT_HISTORY - 1 - back) % BEAT_HISTORY];
+      if (time > 0)
+        voteTempo(now - time, 32 / (back + 2));
+    }
+
+    onsetTimes[onsetIndex] = now;
+    onsetIndex = (onsetIndex + 1) % BEAT_HISTORY;
+
+    // pull the beat clock toward onsets near a predicted beat
+    if (beatPeriod > 0)
+    {
+      int32_t offset = (int32_t)(now - lastBeatTime);
+      if (offset > (int32_t)beatPeriod / 2)
+        offset -= beatPeriod;
+
+      if (abs(offset) < (int32_t)beatPeriod / 4)
+        lastBeatTime += offset / 2;
+    }
+    else
+    {
+      lastBeatTime = now;
+    }
+  }
+
+  // pick the strongest tempo
+  uint8_t best = 0;
+  for (uint8_t i = 1; i < BEAT_BINS; i++)
+  {
+    if (tempoVotes[i] > tempoVotes[best])
+      best = i;
+  }
+
+  if (tempoVotes[best] >= BEAT_MIN_VOTES)
+  {
+    bpm = BEAT_MIN_BPM + best * BEAT_BPM_BIN;
+    beatPeriod = 60000 / bpm;
+  }
+  else
+  {
+    bpm = 0;
+    beatPeriod = 0;
+  }
+
+  // run the beat clock
+  beat = false;
+  downbeat = false;
+
+  if (beatPeriod > 0)
+  {
+    if (now - lastBeatTime >= beatPeriod)
+    {
+      lastBeatTime += beatPeriod;
+
+      // lost way behind (pattern stalled, tempo change), resync
+      if (now - lastBeatTime >= beatPeriod)
+        lastBeatTime = now;
+
+      beat = true;
+      beatCount++;
+      downbeat = (beatCount % 4 == 0);
+    }
+
+    beatPhase = ((now - lastBeatTime) << 8) / beatPeriod;
+  }
+  else
+  {
+    beatPhase = 0;
+  }
+}
+
+
+
+
+// add an inter-onset interval to the tempo histogram
+void voteTempo(uint32_t interval, uint8_t weight)
+{
+  if (interval == 0)
+    return;
+
+  // fold into the tracked range by doubling / halving
+  uint32_t tempo = 60000 / interval;
+  if (tempo == 0)
+    return;
+
+  while (tempo < BEAT_MIN_BPM)
+    tempo *= 2;
+  while (tempo > BEAT_MAX_BPM)
+    tempo /= 2;
+
+  if (tempo < BEAT_MIN_BPM)
+    return;
+
+  // decay old votes so tempo changes are followed
+  for (uint8_t i = 0; i < BEAT_BINS; i++)
+    tempoVotes[i] -= tempoVotes[i] >> 5;
+
+  uint8_t bin = (tempo - BEAT_MIN_BPM + BEAT_BPM_BIN / 2) / BEAT_BPM_BIN;
+  if (bin >= BEAT_BINS)
+    bin = BEAT_BINS - 1;
+
+  // neighbours get a share so nearby intervals reinforce each other
+  tempoVotes[bin] += weight;
+  if (bin > 0)
+    tempoVotes[bin - 1] += weight >> 2;
+  if (bin < BEAT_BINS - 1)
+    tempoVotes[bin + 1] += weight >> 2;
+}
@@ -0,0 +1,254 @@
+/*******************************************************************
+  benchmark.h - times every pattern on the current display
+
+  Runs each pattern (RECTS through the last pattern) for
+  BENCH_FRAMES frames using the recorded audio trace from
+  audioTrace.h (replay source) and a fixed frame time, and
+  prints the mean, p50, p99 and worst frame time in uS.
+  Flash each hardware.h target to compare displays.
+
+  The mean frame time of each pattern can be saved to EEPROM as a
+  baseline ('b' from serial). Later runs ('B') print the change
+  from the baseline so regressions stand out. A baseline saved
+  on a different size display is ignored.
+
+  The host build runs the same benchPattern() for every display
+  in one go and keeps its baseline in a file, see
+  host/auroraBench.cpp.
+
+  Note: only drawing is timed, not the frame pacing
+  (frameScheduler.h).
+
+  vers 1.0  Oct2026
+
+*******************************************************************/
+
+
+#pragma once
+
+
+#define BENCH_FRAMES        100
+#define BENCH_SEED          1234
+#define BENCH_EEPROM_ADDR   0x40
+#define BENCH_CHECK_VALUE   0x5A
+
+
+// prototypes
+struct BenchResult;
+void runBenchmark();
+void beginBenchmark();
+bool benchPattern(uint8_t p, BenchResult& result, uint16_t frames = BENCH_FRAMES);
+void endBenchmark();
+void saveBenchBaseline();
+bool loadBenchBaseline();
+void sortFrameTimes(uint32_t* times, uint16_t count);
+
+
+// frame times of one pattern, uS
+struct BenchResult {
+  uint32_t mean;
+  uint32_t p50;
+  uint32_t p99;
+  uint32_t worst;
+};
+
+
+struct BenchBaseline {
+  uint8_t  checkValue;
+  uint8_t  numPatterns;
+  uint32_t numLEDs;
+  uint32_t mean[LAST];
+};
+
+
+// results
+uint32_t benchFrameTimes[BENCH_FRAMES];
+uint32_t benchMean[LAST];
+bool benchValid = false;
+BenchBaseline benchBaseline;
+
+// settings put back after a run
+uint8_t benchSavedPattern;
+bool benchSavedSimAudio;
+bool benchSavedAutoIncrement;
+AudioSource* benchSavedSource;
+
+
+
+
+void runBenchmark()
+{
+  bool haveBaseline = loadBenchBaseline();
+
+  beginBenchmark();
+
+  Serial.println();
+  Serial.print("benchmark: "); Serial.print(deviceName);
+  Serial.print("  "); Serial.print(kMatrixWidth);
+  Serial.print(" x "); Serial.print(kMatrixHeight);
+  Serial.print("  frames: "); Serial.println(BENCH_FRAMES);
+  Serial.println("pattern             mean     p50     p99   worst   delta");
+
+  for (uint8_t p = RECTS; p < numPatterns; p++)
+  {
+    BenchResult result;
+    if (!benchPattern(p, result))
+    {
+      Serial.println("benchmark aborted");
+      break;
+    }
+    benchMean[p] = result.mean;
+
+    char line[80];
+    snprintf(line, sizeof(line), "%-16s %7lu %7lu %7lu %7lu",
+             patternName[p].c_str(),
+             (unsigned long)result.mean,
+             (unsigned long)result.p50,
+             (unsigned long)result.p99,
+             (unsigned long)result.worst);
+    Serial.print(line);
+
+    if (haveBaseline && benchBaseline.mean[p] > 0)
+    {
+      int32_t delta = (int32_t)benchMean[p] - (int32_t)benchBaseline.mean[p];
+      int32_t pct = delta * 100 / (int32_t)benchBaseline.mean[p];
+      snprintf(line, sizeof(line), " %+6ld%%", (long)pct);
+      Serial.print(line);
+    }
+    Serial.println();
+
+    if (p == numPatterns - 1)
+      benchValid = true;
+  }
+
+  endBenchmark();
+
+  if (!haveBaseline)
+    Serial.println("no baseline saved, use 'b' to save this run");
+  Serial.println();
+}
+
+
+
+
+// replay audio, fixed frame time, no switching
+void beginBenchmark()
+{
+  benchSavedPattern = pattern;
+  benchSavedSimAudio = simAudio;
+  benchSavedAutoIncrement = autoincrement;
+  benchSavedSource = audioSource;
+
+  simAudio = DISABLED;
+  autoincrement = false;
+  audioSource = &replaySource;
+  fixedFrameDt = FRAME_REF_MICROS;
+}
+
+
+
+
+// times frames of pattern p, from the same audio & starting
+// state every time, false if aborted from serial
+bool benchPattern(uint8_t p, BenchResult& result, uint16_t frames)
+{
+  frames = constrain(frames, 1, BENCH_FRAMES);
+
+  pattern = p;
+  randomSeed(BENCH_SEED);
+  replaySource.rewind();
+  resetAudio();
+
+  uint64_t sum = 0;
+  for (uint16_t f = 0; f < frames; f++)
+  {
+    uint32_t t0 = micros();
+    audioPatterns.update();
+    benchFrameTimes[f] = micros() - t0;
+    sum += benchFrameTimes[f];
+
+#ifdef USE_SERIAL
+    // allow a run to be aborted
+    if (Serial.available())
+    {
+      Serial.read();
+      return false;
+    }
+#endif
+  }
+
+  sortFrameTimes(benchFrameTimes, frames);
+  result.mean = sum / frames;
+  result.p50 = benchFrameTimes[frames / 2];
+  result.p99 = benchFrameTimes[(frames * 99) / 100];
+  result.worst = benchFrameTimes[frames - 1];
+  return true;
+}
+
+
+
+
+// put things back the way they were
+void endBenchmark()
+{
+  fixedFrameDt = 0;
+  audioSource = benchSavedSource;
+  simAudio = benchSavedSimAudio;
+  autoincrement = benchSavedAutoIncrement;
+  pattern = benchSavedPattern;
+  resetAudio();
+}
+
+
+
+
+// save the last complete run as the baseline
+void saveBenchBaseline()
+{
+  if (!benchValid)
+  {
+    Serial.println("run the benchmark first");
+    return;
+  }
+
+  benchBaseline.checkValue = BENCH_CHECK_VALUE;
+  benchBaseline.numPatterns = numPatterns;
+  benchBaseline.numLEDs = kNumLEDs;
+  for (uint8_t p = 0; p < numPatterns; p++)
+    benchBaseline.mean[p] = benchMean[p];
+
+  EEPROM.put(BENCH_EEPROM_ADDR, benchBaseline);
+  Serial.println("benchmark baseline saved");
+}
+
+
+
+
+bool loadBenchBaseline()
+{
+  EEPROM.get(BENCH_EEPROM_ADDR, benchBaseline);
+
+  return benchBaseline.checkValue == BENCH_CHECK_VALUE &&
+         benchBaseline.numPatterns == numPatterns &&
+         benchBaseline.numLEDs == kNumLEDs;
+}
+
+
+
+
+// simple insertion sort, only used for a few hundred values
+void sortFrameTimes(uint32_t* times, uint16_t count)
+{
+  for (uint16_t i = 1; i < count; i++)
+  {
+    uint32_t value = times[i];
+    int16_t j = i - 1;
+
+    while (j >= 0 && times[j] > value)
+    {
+      times[j + 1] = times[j];
+      j--;
+    }
+    times[j + 1] = value;
+  }
+}
@@ -0,0 +1,699 @@
+/*************************************************************
+
+   canvas.h - where the patterns draw and how a frame gets
+   to the display
+
+   Patterns draw through canvas (same calls as backgroundLayer)
+   and rgb24Buffer, and AudioPatterns::update() calls
+   canvas.present() once per frame.
+
+   Drawing: canvas rasterizes into the buffer itself, whichever
+   buffer that is, clipping once per primitive rather than per
+   pixel. Spans (drawHLine(), fillRectangle(), the rows of
+   fillTriangle() and fillScreen()) are stored a word at a time,
+   lines on the screen end to end walk a pointer. Bars should
+   be one fillRectangle() rather than a drawLine() per column.
+
+   Double buffered (default): the canvas is the SmartMatrix
+   back buffer. present() is swapBuffers(), which waits for the
+   refresh to pick up the frame and copies it back.
+
+   USE_TRIPLE_BUFFER (see hardware.h): the canvas is a third
+   buffer in DMAMEM that's never shown. present() copies it to
+   the back buffer and queues the swap without waiting. If the
+   last frame hasn't been picked up yet, the present is skipped
+   and the next frame goes instead, so drawing never waits for
+   the refresh. Costs kNumLEDs * 3 bytes (108K on 192x192) and
+   assumes rotation0.
+
+   Render scale: a pattern can draw at 1/2 or 1/4 size
+   (setRenderScale(1) or (2), from patternRenderShift[]) into a
+   small buffer that present() blows up to the full screen,
+   each pixel becoming a 2x2 or 4x4 block. width() and height()
+   give the size to draw. Only done on screens at least
+   RENDER_SCALE_MIN_WIDTH wide, smaller ones always draw at full
+   size. With USE_TRIPLE_BUFFER the small buffer is the start of
+   canvasBuffer, which isn't drawn in while the scale is on, so
+   it costs nothing. Otherwise it needs USE_RENDER_SCALE
+   (hardware.h) and costs kNumLEDs * 3 / 4 bytes, without it
+   every pattern draws at full size.
+
+   Tiles: the canvas is split into 16x16 tiles with one bit
+   each, set when anything is drawn in the tile. rgb24DimAll()
+   only dims tiles with the bit set and clears it once the tile
+   has faded to black, so sparse patterns only pay for the few
+   tiles that are lit. Writes straight into rgb24Buffer have to
+   mark their tile (setIndex() / markIndex() / markArea()). The
+   Effects stream and smear passes skip tiles that are black in
+   the row and where it takes its tail from, and symmetry.apply()
+   sets the bits from what it copies. A pattern that can't keep
+   them can use trackTiles(false) to get every tile marked each
+   frame.
+
+   Scrolling (USE_TRIPLE_BUFFER only): for patterns that move
+   everything down a row each frame and only draw the new top
+   row (setScrolling(true), from patternScrolls[]). The buffer
+   becomes a ring of rows and scrollDown() just moves the row
+   where the screen starts and clears the new top row, instead
+   of copying the whole frame. present() copies the ring out top
+   row first, which it was copying anyway. canvas and fb (set up
+   by scrollDown()) draw through the ring; writes to rgb24Buffer
+   by index have to use fb.index(). scrollDown() moves the tile
+   bits down with the rows. Without the triple buffer scrollDown()
+   copies rows.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#define MAX_RENDER_SHIFT          2         // 1/4 size
+#define RENDER_SCALE_MIN_WIDTH    128
+
+#define TILE_SHIFT                4         // 16x16 pixel tiles
+#define TILE_SIZE                 (1 << TILE_SHIFT)
+#define MAX_TILE_ROWS             ((kMaxScreenWidth + TILE_SIZE - 1) / TILE_SIZE)
+
+
+// drawn at 1/2 or 1/4 size, scaled up in present()
+#ifdef USE_TRIPLE_BUFFER
+DMAMEM rgb24 canvasBuffer[kNumLEDs];
+rgb24* const smallBuffer = canvasBuffer;
+#define HAVE_SMALL_BUFFER
+#elif defined USE_RENDER_SCALE
+DMAMEM rgb24 smallBuffer[kNumLEDs / 4];
+#define HAVE_SMALL_BUFFER
+#endif
+
+
+
+class Canvas {
+  public:
+    uint32_t presented = 0;         // frames sent to the display
+    uint32_t skipped = 0;           // frames dropped, refresh was busy
+
+
+    void begin()
+    {
+      _screenWidth = matrix.getScreenWidth();
+      _screenHeight = matrix.getScreenHeight();
+      presented = 0;
+      skipped = 0;
+      setRenderScale(0);
+    }
+
+
+    // draw at full (0), 1/2 (1) or 1/4 (2) size
+    void setRenderScale(uint8_t shift)
+    {
+#ifdef HAVE_SMALL_BUFFER
+      if (shift > MAX_RENDER_SHIFT || _screenWidth < RENDER_SCALE_MIN_WIDTH)
+        shift = 0;
+
+      if (shift != _shift && shift > 0)
+      {
+        for (uint32_t i = 0; i < kNumLEDs / 4; i++)
+          smallBuffer[i] = rgb24(0, 0, 0);
+      }
+#ifdef USE_TRIPLE_BUFFER
+      // the small frame is in the canvas buffer, full size starts black
+      else if (shift == 0 && _shift > 0)
+      {
+        for (uint32_t i = 0; i < kNumLEDs; i++)
+          canvasBuffer[i] = rgb24(0, 0, 0);
+      }
+#endif
+#else
+      shift = 0;
+#endif
+
+      setScrolling(false);
+      _shift = shift;
+      _width = _screenWidth >> shift;
+      _height = _screenHeight >> shift;
+
+      _tileCols = (_width + TILE_SIZE - 1) >> TILE_SHIFT;
+      _tileRows = (_height + TILE_SIZE - 1) >> TILE_SHIFT;
+      _tileMask = (_tileCols >= 32) ? 0xFFFFFFFF : (1UL << _tileCols) - 1;
+      markAll();
+    }
+
+
+    uint8_t renderShift() { return _shift; }
+    uint16_t width() { return _width; }
+    uint16_t height() { return _height; }
+    uint32_t numPixels() { return (uint32_t)_width * _height; }
+
+
+    // the buffer patterns draw into
+    rgb24* buffer()
+    {
+#ifdef HAVE_SMALL_BUFFER
+      if (_shift > 0)
+        return smallBuffer;
+#endif
+      return screenBuffer();
+    }
+
+
+    // only tracked patterns keep the tile bits, for the others
+    // every tile is treated as lit
+    void trackTiles(bool track)
+    {
+      _tracking = track;
+      markAll();
+    }
+
+
+    // called before each frame is drawn
+    void beginFrame()
+    {
+      if (!_tracking)
+        markAll();
+    }
+
+
+    // ring of rows for scrolling patterns, see above. Has to come
+    // after setRenderScale(), it only works at full size
+    void setScrolling(bool scroll)
+    {
+#ifdef USE_TRIPLE_BUFFER
+      scroll = scroll && _shift == 0;
+#else
+      scroll = false;
+#endif
+      if (!scroll && _top > 0)
+        unroll();
+
+      _scrolling = scroll;
+    }
+
+    bool scrolling() { return _scrolling; }
+    uint16_t scrollTop() { return _top; }
+
+
+    // move everything down a row and clear the top row
+    void scrollDown()
+    {
+      uint32_t rowBytes = _width * sizeof(rgb24);
+      rgb24* pixels = buffer();
+
+      if (_scrolling)
+      {
+        _top = (_top == 0) ? _height - 1 : _top - 1;
+        fb.scrollTo(_top);
+        pixels += (uint32_t)_top * _width;
+      }
+      else
+        memmove(pixels + _width, pixels, (_height - 1) * rowBytes);
+
+      for (uint16_t x = 0; x < _width; x++)
+        pixels[x] = rgb24(0, 0, 0);
+
+      // a lit tile now reaches a row into the one below it
+      for (uint8_t ty = _tileRows - 1; ty > 0; ty--)
+        _tiles[ty] |= _tiles[ty - 1];
+    }
+
+
+    uint8_t tileRows() { return _tileRows; }
+    uint32_t tileRowBits(uint8_t ty) { return _tiles[ty]; }
+
+    void clearTile(uint8_t tx, uint8_t ty)
+    {
+      _tiles[ty] &= ~(1UL << tx);
+    }
+
+    void markTile(uint8_t tx, uint8_t ty)
+    {
+      _tiles[ty] |= 1UL << tx;
+    }
+
+    // for passes that know exactly which tiles they left lit
+    void setTileRowBits(uint8_t ty, uint32_t bits)
+    {
+      _tiles[ty] = bits & _tileMask;
+    }
+
+    // checks every pixel, for tiles a pass may have left black
+    bool tileIsBlack(uint8_t tx, uint8_t ty)
+    {
+      uint16_t x0 = tx << TILE_SHIFT;
+      uint16_t bytes = (min(x0 + TILE_SIZE, (int)_width) - x0) * sizeof(rgb24);
+      uint16_t y1 = min((ty + 1) << TILE_SHIFT, (int)_height);
+
+      for (uint16_t y = ty << TILE_SHIFT; y < y1; y++)
+      {
+        const uint8_t* pixels = (const uint8_t*)(rowPtr(y) + x0);
+        uint8_t lit = 0;
+
+        for (uint16_t i = 0; i < bytes; i++)
+          lit |= pixels[i];
+        if (lit)
+          return false;
+      }
+      return true;
+    }
+
+    void markAll()
+    {
+      for (uint8_t ty = 0; ty < _tileRows; ty++)
+        _tiles[ty] = _tileMask;
+    }
+
+    void markPixel(int16_t x, int16_t y)
+    {
+      if (x >= 0 && x < _width && y >= 0 && y < _height)
+        _tiles[y >> TILE_SHIFT] |= 1UL << (x >> TILE_SHIFT);
+    }
+
+    // i is a buffer index, so through the ring when scrolling
+    void markIndex(uint32_t i)
+    {
+      uint16_t y = i / _width;
+      if (_top > 0)
+        y = (y >= _top) ? y - _top : y + _height - _top;
+      markPixel(i % _width, y);
+    }
+
+    // mark every tile touched by a box, corners in any order
+    void markArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+    {
+      if (x0 > x1) swapInt(x0, x1);
+      if (y0 > y1) swapInt(y0, y1);
+      x0 = max(x0, (int16_t)0);
+      y0 = max(y0, (int16_t)0);
+      x1 = min(x1, (int16_t)(_width - 1));
+      y1 = min(y1, (int16_t)(_height - 1));
+      if (x0 > x1 || y0 > y1)
+        return;
+
+      uint32_t bits = 0;
+      for (uint8_t tx = x0 >> TILE_SHIFT; tx <= x1 >> TILE_SHIFT; tx++)
+        bits |= 1UL << tx;
+      for (uint8_t ty = y0 >> TILE_SHIFT; ty <= y1 >> TILE_SHIFT; ty++)
+        _tiles[ty] |= bits;
+    }
+
+
+    // start of screen row y, through the ring when scrolling
+    rgb24* row(int16_t y)
+    {
+      return rowPtr(y);
+    }
+
+
+    // write a pixel by buffer index, e.g. fb.index(x, y)
+    void setIndex(uint32_t i, const rgb24& color)
+    {
+      buffer()[i] = color;
+      markIndex(i);
+    }
+
+
+    // send the frame to the display, returns false if skipped
+    bool present()
+    {
+#ifdef USE_TRIPLE_BUFFER
+      if (backgroundLayer.isSwapPending())
+      {
+        skipped++;
+        return false;
+      }
+
+      if (_shift > 0)
+        upscale(backgroundLayer.backBuffer());
+      else
+        copyRing(backgroundLayer.backBuffer());
+      backgroundLayer.swapBuffers(false);
+#else
+      if (_shift > 0)
+        upscale(backgroundLayer.backBuffer());
+      backgroundLayer.swapBuffers();
+#endif
+      presented++;
+      return true;
+    }
+
+
+
+    void drawPixel(int16_t x, int16_t y, const rgb24& color)
+    {
+      if (x < 0 || x >= _width || y < 0 || y >= _height)
+        return;
+
+      _tiles[y >> TILE_SHIFT] |= 1UL << (x >> TILE_SHIFT);
+      buffer()[pixelIndex(x, y)] = color;
+    }
+
+
+    // x0 to x1 on row y, ends included and in any order
+    void drawHLine(int16_t x0, int16_t x1, int16_t y, const rgb24& color)
+    {
+      if (x0 > x1) swapInt(x0, x1);
+      if (!clipSpan(x0, x1, _width) || y < 0 || y >= _height)
+        return;
+
+      markArea(x0, y, x1, y);
+      fillPixels(rowPtr(y) + x0, x1 - x0 + 1, color);
+    }
+
+
+    void drawVLine(int16_t x, int16_t y0, int16_t y1, const rgb24& color)
+    {
+      if (y0 > y1) swapInt(y0, y1);
+      if (!clipSpan(y0, y1, _height) || x < 0 || x >= _width)
+        return;
+
+      markArea(x, y0, x, y1);
+      for (int16_t y = y0; y <= y1; y++)
+        rowPtr(y)[x] = color;
+    }
+
+
+    // solid box, corners included and in any order
+    void fillRectangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const rgb24& color)
+    {
+      if (x0 > x1) swapInt(x0, x1);
+      if (y0 > y1) swapInt(y0, y1);
+      if (!clipSpan(x0, x1, _width) || !clipSpan(y0, y1, _height))
+        return;
+
+      markArea(x0, y0, x1, y1);
+      for (int16_t y = y0; y <= y1; y++)
+        fillPixels(rowPtr(y) + x0, x1 - x0 + 1, color);
+    }
+
+
+    // Bresenham. Lines that are on the screen end to end are
+    // drawn with a pointer and no checks per pixel
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const rgb24& color)
+    {
+      if (y0 == y1)
+      {
+        drawHLine(x0, x1, y0, color);
+        return;
+      }
+      if (x0 == x1)
+      {
+        drawVLine(x0, y0, y1, color);
+        return;
+      }
+
+      int16_t dx = abs(x1 - x0);
+      int16_t dy = -abs(y1 - y0);
+      int8_t sx = (x0 < x1) ? 1 : -1;
+      int8_t sy = (y0 < y1) ? 1 : -1;
+      int16_t error = dx + dy;
+
+      bool inside = x0 >= 0 && x0 < _width && x1 >= 0 && x1 < _width &&
+                    y0 >= 0 && y0 < _height && y1 >= 0 && y1 < _height;
+
+      if (inside && _top == 0)
+      {
+        markArea(x0, y0, x1, y1);
+
+        rgb24* pixel = buffer() + (uint32_t)y0 * _width + x0;
+        int32_t rowStep = (sy > 0) ? _width : -(int32_t)_width;
+        int16_t steps = max(dx, (int16_t)-dy);
+
+        for (int16_t i = 0; i <= steps; i++)
+        {
+          *pixel = color;
+
+          int16_t e2 = 2 * error;
+          if (e2 >= dy)
+          {
+            error += dy;
+            pixel += sx;
+          }
+          if (e2 <= dx)
+          {
+            error += dx;
+            pixel += rowStep;
+          }
+        }
+        return;
+      }
+
+      while (true)
+      {
+        drawPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1)
+          break;
+
+        int16_t e2 = 2 * error;
+        if (e2 >= dy)
+        {
+          error += dy;
+          x0 += sx;
+        }
+        if (e2 <= dx)
+        {
+          error += dx;
+          y0 += sy;
+        }
+      }
+    }
+
+
+    void drawRectangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const rgb24& color)
+    {
+      drawHLine(x0, x1, y0, color);
+      drawHLine(x0, x1, y1, color);
+      drawVLine(x0, y0, y1, color);
+      drawVLine(x1, y0, y1, color);
+    }
+
+
+    // scanline fill, vertices sorted top to bottom. The edges step
+    // down in 16.16 fixed point and each row is one span
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, const rgb24& color)
+    {
+      if (y0 > y1) { swapInt(x0, x1); swapInt(y0, y1); }
+      if (y1 > y2) { swapInt(x1, x2); swapInt(y1, y2); }
+      if (y0 > y1) { swapInt(x0, x1); swapInt(y0, y1); }
+
+      // long edge 0 -> 2, short edges 0 -> 1 then 1 -> 2
+      int32_t longX = (int32_t)x0 << 16;
+      int32_t longStep = edgeStep(x0, y0, x2, y2);
+      int32_t shortX = (int32_t)x0 << 16;
+      int32_t shortStep = edgeStep(x0, y0, x1, y1);
+
+      // a flat top starts on the second short edge
+      if (y1 == y0)
+      {
+        shortX = (int32_t)x1 << 16;
+        shortStep = edgeStep(x1, y1, x2, y2);
+      }
+
+      for (int16_t y = y0; y <= y2; y++)
+      {
+        if (y == y1 && y1 != y0)
+        {
+          shortX = (int32_t)x1 << 16;
+          shortStep = edgeStep(x1, y1, x2, y2);
+        }
+
+        if (y >= _height)
+          break;
+
+        if (y >= 0)
+          drawHLine(roundFixed(longX), roundFixed(shortX), y, color);
+
+        longX += longStep;
+        shortX += shortStep;
+      }
+    }
+
+
+    void fillScreen(const rgb24& color)
+    {
+      bool black = (color.red | color.green | color.blue) == 0;
+      for (uint8_t ty = 0; ty < _tileRows; ty++)
+        _tiles[ty] = black ? 0 : _tileMask;
+
+      fillPixels(buffer(), numPixels(), color);
+    }
+
+
+  private:
+    uint16_t _screenWidth = kMatrixWidth;
+    uint16_t _screenHeight = kMatrixHeight;
+    uint16_t _width = kMatrixWidth;
+    uint16_t _height = kMatrixHeight;
+    uint8_t _shift = 0;
+    bool _scrolling = false;
+    uint16_t _top = 0;                  // ring row the screen starts at
+
+    uint32_t _tiles[MAX_TILE_ROWS];     // one bit per tile, set = may be lit
+    uint32_t _tileMask = 0;
+    uint8_t _tileCols = 0;
+    uint8_t _tileRows = 0;
+    bool _tracking = false;
+
+
+    // full size buffer that gets shown
+    rgb24* screenBuffer()
+    {
+#ifdef USE_TRIPLE_BUFFER
+      return canvasBuffer;
+#else
+      return backgroundLayer.backBuffer();
+#endif
+    }
+
+
+    uint32_t pixelIndex(uint16_t x, uint16_t y)
+    {
+      if (_top > 0)
+      {
+        y += _top;
+        if (y >= _height)
+          y -= _height;
+      }
+      return (uint32_t)y * _width + x;
+    }
+
+
+    // the ring to dest, the row at _top first
+    void copyRing(rgb24* dest)
+    {
+      rgb24* pixels = screenBuffer();
+      uint32_t count = (uint32_t)_width * _height;
+      uint32_t split = (uint32_t)_top * _width;
+
+      memcpy(dest, pixels + split, (count - split) * sizeof(rgb24));
+      memcpy(dest + count - split, pixels, split * sizeof(rgb24));
+    }
+
+
+    // rotate the ring back in place so the screen starts at row 0
+    // again, reversing both parts and then the whole lot
+    void unroll()
+    {
+      reverseRows(0, _top);
+      reverseRows(_top, _height);
+      reverseRows(0, _height);
+      _top = 0;
+      fb.scrollTo(0);
+    }
+
+    void reverseRows(uint16_t first, uint16_t last)
+    {
+      rgb24* pixels = screenBuffer();
+
+      if (last < first + 2)
+        return;
+
+      for (uint16_t a = first, b = last - 1; a < b; a++, b--)
+      {
+        rgb24* rowA = pixels + (uint32_t)a * _width;
+        rgb24* rowB = pixels + (uint32_t)b * _width;
+        for (uint16_t x = 0; x < _width; x++)
+        {
+          rgb24 t = rowA[x];
+          rowA[x] = rowB[x];
+          rowB[x] = t;
+        }
+      }
+    }
+
+
+    // nearest neighbour blow up of smallBuffer. Each small row is
+    // widened once, then copied down for the rest of the block
+    void upscale(rgb24* dest)
+    {
+#ifdef HAVE_SMALL_BUFFER
+      uint8_t block = 1 << _shift;
+      uint32_t rowBytes = _screenWidth * sizeof(rgb24);
+
+      for (uint16_t y = 0; y < _height; y++)
+      {
+        const rgb24* src = &smallBuffer[y * _width];
+        rgb24* row = &dest[(y << _shift) * _screenWidth];
+        rgb24* out = row;
+
+        for (uint16_t x = 0; x < _width; x++)
+        {
+          rgb24 color = src[x];
+          for (uint8_t i = 0; i < block; i++)
+            *out++ = color;
+        }
+
+        for (uint8_t i = 1; i < block; i++)
+          memcpy(row + i * _screenWidth, row, rowBytes);
+      }
+#endif
+    }
+
+
+    void swapInt(int16_t& a, int16_t& b)
+    {
+      int16_t t = a; a = b; b = t;
+    }
+
+
+    // x step per row of an edge, 16.16
+    int32_t edgeStep(int16_t xa, int16_t ya, int16_t xb, int16_t yb)
+    {
+      if (yb == ya)
+        return 0;
+      return ((int32_t)(xb - xa) << 16) / (yb - ya);
+    }
+
+    int16_t roundFixed(int32_t x)
+    {
+      return (x + 0x8000) >> 16;
+    }
+
+
+    // clamp first..last to 0..size - 1, false if nothing's left
+    bool clipSpan(int16_t& first, int16_t& last, uint16_t size)
+    {
+      if (last < 0 || first >= (int16_t)size)
+        return false;
+      first = max(first, (int16_t)0);
+      last = min(last, (int16_t)(size - 1));
+      return true;
+    }
+
+
+    // start of row y, through the ring when scrolling
+    rgb24* rowPtr(int16_t y)
+    {
+      return buffer() + pixelIndex(0, y);
+    }
+
+
+    // a run of pixels in one color. 4 pixels are 3 words, so
+    // after lining up on a word the color is stored 3 words at a
+    // time
+    void fillPixels(rgb24* pixels, uint32_t count, const rgb24& color)
+    {
+      while (count > 0 && ((uintptr_t)pixels & 3))
+      {
+        *pixels++ = color;
+        count--;
+      }
+
+      if (count >= 4)
+      {
+        rgb24 four[4] = { color, color, color, color };
+        uint32_t words[3];
+        memcpy(words, four, sizeof(words));
+
+        for (; count >= 4; count -= 4, pixels += 4)
+          memcpy(pixels, words, sizeof(words));
+      }
+
+      while (count > 0)
+      {
+        *pixels++ = color;
+        count--;
+      }
+    }
+};
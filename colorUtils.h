@@ -13,11 +13,11 @@
 #pragma once
 
 #include <FastLED.h>
+#include "palettes.h"
 
 
 // prototypes
 float randomf(float lower, float upper);
-uint16_t XY(uint16_t x, uint16_t y);
 void rgb24DimAll(uint8_t sf);
 rgb24 rgb24SetColorBrightness(rgb24 color, uint8_t sf);
 rgb24 hsv2rbg24(uint8_t h, uint8_t s, uint8_t v);
@@ -88,31 +88,6 @@ float randomf(float lower, float upper)
 
 
 
-// translates from x, y position into a
-// linear index into the LED array
-uint16_t XY(uint16_t x, uint16_t y)
-{
-#ifdef BOUNDS_CHECKING
-  if (x > kScreenWidth - 1)
-  {
-    printValue("x out of bounds", x);
-    x = 0;
-    pattern = 0;
-  }
-
-  if (y > kScreenHeight - 1)
-  {
-    printValue("y out of bounds", y);
-    y = 0;
-    pattern = 0;
-  }
-#endif
-
-  return (y * kScreenWidth) + x;
-}
-
-
-
 // scale pixel brightness, sf of 255 = 0 (off), sf of 0 = no scaling
 rgb24 rgb24SetColorBrightness(rgb24 color, uint8_t sf)
 {
@@ -124,32 +99,38 @@ rgb24 rgb24SetColorBrightness(rgb24 color, uint8_t sf)
 
 
 
-// dim entire display
+// dim entire display, only touches the back buffer.
+// AudioPatterns::update() presents it once the pattern is drawn.
+// Only the lit tiles are dimmed, see canvas.h
 void rgb24DimAll(uint8_t sf)
 {
-  rgb24 color;
-
-  while (backgroundLayer.isSwapPending())
-    ;
-
-  // get a pointer to the led array buffer
-  rgb24Buffer = backgroundLayer.backBuffer();
+  uint16_t width = canvas.width();
+  uint16_t height = canvas.height();
 
-  // apply dimming scale factor to each led using fastLed library
-  for (uint32_t i = 0; i < kNumLEDs; i++)
+  for (uint8_t ty = 0; ty < canvas.tileRows(); ty++)
   {
-    color = rgb24Buffer[i];
-    color.red = scale8(color.red, sf);
-    color.green = scale8(color.green, sf);
-    color.blue = scale8(color.blue, sf);
-    rgb24Buffer[i] = color;
+    uint32_t bits = canvas.tileRowBits(ty);
+    uint16_t y0 = ty << TILE_SHIFT;
+    uint16_t y1 = min(y0 + TILE_SIZE, (int)height);
+
+    for (uint8_t tx = 0; bits != 0; tx++, bits >>= 1)
+    {
+      if (!(bits & 1))
+        continue;
+
+      uint16_t x0 = tx << TILE_SHIFT;
+      uint16_t x1 = min(x0 + TILE_SIZE, (int)width);
+      uint8_t lit = 0;
+
+      // scale8() each color byte of each tile row, 4 at a time
+      for (uint16_t y = y0; y < y1; y++)
+        lit |= scale8Bytes((uint8_t*)(canvas.row(y) + x0), (x1 - x0) * 3, sf);
+
+      // faded out, skip it until something is drawn there
+      if (!lit)
+        canvas.clearTile(tx, ty);
+    }
   }
-
-  // update display
-  backgroundLayer.swapBuffers();
-
-  // get an updated pointer to the led array buffer
-  rgb24Buffer = backgroundLayer.backBuffer();
 }
 
 
@@ -157,106 +138,22 @@ void rgb24DimAll(uint8_t sf)
 
 // 8-bit color wheel - this version starts
 // at blue (0) -> green (85) -> red (170) -> blue (255)
-// to match the defined colors8 and colors16
+// to match the defined colors8 and colors16.
+// Read from the table in palettes.h
 rgb24 wheel8(uint8_t wheelPos)
 {
-  rgb24 color;
-
-  // blue -> green
-  if (wheelPos < 85)
-  {
-    color.red = 0;
-    color.green =  wheelPos * 3;
-    color.blue = 255 - (wheelPos * 3);
-  }
-
-  // green to red
-  else if (wheelPos < 170)
-  {
-    wheelPos -= 85;
-
-    color.red = wheelPos * 3;
-    color.green = 255 - (wheelPos * 3);
-    color.blue = 0;
-  }
-
-  // red to blue
-  else
-  {
-    wheelPos -= 170;
-
-    color.red = 255 - (wheelPos * 3);
-    color.green =  0;
-    color.blue = wheelPos * 3;
-  }
-
-  // printColor(color);
-
-  return color;
+  return paletteTable(PALETTE_WHEEL)[wheelPos];
 }
 
 
 
 
 
-// saturated 8-bit color wheel - experimental
+// saturated 8-bit color wheel, blue -> cyan -> green ->
+// yellow -> red -> violet -> blue, from palettes.h
 rgb24 wheel8Sat(uint8_t wheelPos, uint8_t offset = 0)
 {
-  rgb24 color;
-
-  wheelPos += offset;
-
-  // 0 to 42 blue -> cyan (43 steps)
-  if (wheelPos < 43)
-  {
-    color.red = 0;
-    color.green =  wheelPos * 6;
-    color.blue = 255;
-  }
-
-  // 43 to 85 cyan -> green (43 steps)
-  else if (wheelPos < 86)
-  {
-    color.red = 0;
-    color.green =  255;
-    color.blue = 255 - ((wheelPos - 43) * 6);
-  }
-
-  // 86 to 127 green -> yellow (42 steps)
-  else if (wheelPos < 128)
-  {
-    color.red = ((wheelPos - 86) * 6);
-    color.green = 255;
-    color.blue = 0;
-  }
-
-  // 128 to 170 yellow -> red (43 steps)
-  else if (wheelPos < 171)
-  {
-    color.red = 255;
-    color.green = 255 - ((wheelPos -  128) * 6);
-    color.blue = 0;
-  }
-
-  // 171 to 212 red to violet (42 steps)
-  else if (wheelPos < 213)
-  {
-    color.red = 255;
-    color.green =  0;
-    color.blue = (wheelPos - 171) * 6;
-  }
-
-  // 213 to 255  violet -> blue (43 steps)
-  else
-  {
-    color.red = 255 - ((wheelPos - 213) * 6) ;
-    color.green =  0;
-    color.blue = 255;
-  }
-
-  // printColor(color);
-
-  return color;
+  return paletteTable(PALETTE_WHEEL_SAT)[(uint8_t)(wheelPos + offset)];
 }
 
 
@@ -70,3 +70,125 @@ uint8_t mapcos8(uint8_t theta, uint8_t lowest = 0, uint8_t highest = 255)
   uint8_t result = lowest + scaledbeat;
   return result;
 }
+
+
+
+
+// scale8() on the 4 bytes of a word, m = 1 + scale
+inline uint32_t scale8Word(uint32_t w, uint32_t m)
+{
+  uint32_t even, odd;
+
+#ifdef __ARM_FEATURE_DSP
+  asm("uxtb16 %0, %1" : "=r" (even) : "r" (w));
+  asm("uxtb16 %0, %1, ror #8" : "=r" (odd) : "r" (w));
+#else
+  even = w & 0x00FF00FF;
+  odd = (w >> 8) & 0x00FF00FF;
+#endif
+
+  // each lane is at most 255 * 256, so lanes can't carry
+  return ((even * m >> 8) & 0x00FF00FF) | ((odd * m) & 0xFF00FF00);
+}
+
+
+
+// qadd8() on the 4 bytes of a word
+inline uint32_t qadd8Word(uint32_t a, uint32_t b)
+{
+#ifdef __ARM_FEATURE_DSP
+  uint32_t sum;
+  asm("uqadd8 %0, %1, %2" : "=r" (sum) : "r" (a), "r" (b));
+  return sum;
+#else
+  // add the low 7 bits, then the top bits without carry, and
+  // saturate the bytes that carried out
+  uint32_t sum = ((a & 0x7F7F7F7F) + (b & 0x7F7F7F7F)) ^ ((a ^ b) & 0x80808080);
+  uint32_t carry = ((a & b) | ((a | b) & ~sum)) & 0x80808080;
+  return sum | ((carry >> 7) * 0xFF);
+#endif
+}
+
+
+
+// scale8() a run of bytes in place, e.g. a row of the rgb24
+// buffer treated as plain bytes. Bit exact with scale8()
+// (FASTLED_SCALE8_FIXED: i * (1 + scale) >> 8), but does 4
+// bytes per step: the even and odd bytes are split into two
+// words of 16-bit lanes (UXTB16 on the M4/M7), one multiply
+// scales both lanes and the results are masked back together.
+// Returns the OR of all the results, 0 = all black.
+uint8_t scale8Bytes(uint8_t* bytes, uint32_t count, uint8_t scale)
+{
+  uint32_t m = 1 + (uint32_t)scale;
+  uint32_t lit = 0;
+
+  // single bytes up to a word boundary
+  while (count > 0 && ((uintptr_t)bytes & 3))
+  {
+    *bytes = (*bytes * m) >> 8;
+    lit |= *bytes++;
+    count--;
+  }
+
+  for (; count >= 4; count -= 4, bytes += 4)
+  {
+    uint32_t w;
+    memcpy(&w, bytes, 4);
+    w = scale8Word(w, m);
+    memcpy(bytes, &w, 4);
+    lit |= w;
+  }
+
+  // and the tail
+  while (count > 0)
+  {
+    *bytes = (*bytes * m) >> 8;
+    lit |= *bytes++;
+    count--;
+  }
+
+  return (lit | (lit >> 8) | (lit >> 16) | (lit >> 24)) & 0xFF;
+}
+
+
+
+
+// dst = scale8(qadd8(dst, src), scale) over a run of bytes, 4 at
+// a time, bit exact with rgb24 += then nscale8(). This is one
+// step of a stream / smear pass: dst is a row (or part of one)
+// and src the row or pixel it takes its tail from. src may
+// overlap dst if it's ahead of it (src >= dst), each word of
+// src is read before the word of dst under it is written.
+// Returns the OR of all the results, 0 = all black.
+uint8_t addScale8Bytes(uint8_t* dst, const uint8_t* src, uint32_t count, uint8_t scale)
+{
+  uint32_t m = 1 + (uint32_t)scale;
+  uint32_t lit = 0;
+
+  while (count > 0 && ((uintptr_t)dst & 3))
+  {
+    *dst = (qadd8(*dst, *src++) * m) >> 8;
+    lit |= *dst++;
+    count--;
+  }
+
+  for (; count >= 4; count -= 4, dst += 4, src += 4)
+  {
+    uint32_t a, b;
+    memcpy(&a, dst, 4);
+    memcpy(&b, src, 4);
+    a = scale8Word(qadd8Word(a, b), m);
+    memcpy(dst, &a, 4);
+    lit |= a;
+  }
+
+  while (count > 0)
+  {
+    *dst = (qadd8(*dst, *src++) * m) >> 8;
+    lit |= *dst++;
+    count--;
+  }
+
+  return (lit | (lit >> 8) | (lit >> 16) | (lit >> 24)) & 0xFF;
+}
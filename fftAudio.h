@@ -0,0 +1,361 @@
+/*************************************************************
+
+   fftAudio.h - software spectrum analyzer, an alternative to
+   the MSGEQ7 for the larger displays
+
+   The line input is sampled by the ADC from an IntervalTimer
+   into a ring buffer. Like the MSGEQ7 sampler (audioSampler.h,
+   whose ADC it shares) each tick collects the conversion the
+   last one started with readSingle() and starts the next with
+   startSingleRead(), so the ISR never waits on analogRead(). Each frame the newest
+   FFT_SIZE samples are windowed and run through a 16-bit fixed
+   point radix-2 FFT, and the bin magnitudes are collected into
+   FFT_BANDS log spaced bands (fftBands[]). The bands are also
+   grouped into the 7 MSGEQ7 bands so FftSource can be used like
+   any other AudioSource and no pattern has to change.
+
+   The full resolution is used too: readAudio() scales fftBands[]
+   with the same background / gain as the 7 bands into fftAudio[]
+   and keeps peaks of them in fftPeaks[], and fftColumnMap
+   (bandMap.h) spreads those across the screen for analyzer7,
+   analyzer16 and fallingSpectro while the FFT is the source.
+
+   Cost on a Teensy 4.x: well under 1 uS per sample in the ISR
+   and roughly 60 uS per frame for the 512 point FFT. The
+   time of the last FFT is in fftMicros.
+
+   Note: at 20 kHz sampling the top band ends at 10 kHz, so the
+   MSGEQ7 16 kHz group is centered at 8 kHz instead.
+
+   Needs USE_FFT_AUDIO (see readAudio.h)
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+// the ADC object
+#include "audioSampler.h"
+
+
+#define FFT_SIZE            512       // must be a power of 2
+#define FFT_LOG2            9
+#define FFT_SAMPLE_RATE     20000     // Hz
+#define FFT_BANDS           64        // 32, 64 or 128
+#define FFT_LOW_FREQ        40.0      // Hz, bottom of the first band
+#define FFT_LEVEL_SF        64        // magnitude -> 10-bit level, / 256
+#define FFT_BACKGROUND      60        // offset to look like the MSGEQ7
+
+// line input to the ADC, defaults to the MSGEQ7 pin
+#ifndef FFT_AUDIO_PIN
+#define FFT_AUDIO_PIN       MSGEQ7_AUDIO_PIN
+#endif
+
+
+// prototypes
+void startFftSampler();
+void stopFftSampler();
+void fftSampleISR();
+void fftSetup();
+void fft16(int16_t* re, int16_t* im);
+void calcFftBands();
+void scaleFftBands();
+void findFftPeaks(audio_t decay);
+
+
+// results
+uint16_t fftBands[FFT_BANDS];       // 10-bit level for each log spaced band
+uint32_t fftMicros = 0;             // time taken by the last calcFftBands()
+audio_t fftAudio[FFT_BANDS];        // scaled like audio[]
+audio_t fftPeaks[FFT_BANDS];        // and their peaks, like peaks[]
+
+// MSGEQ7 band centers used to group the fft bands into 7
+const float fftBand7Freq[EQ_BANDS7] = {63, 160, 400, 1000, 2500, 6250, 16000};
+
+// ring buffer written by the sample ISR
+volatile uint16_t fftRing[FFT_SIZE];
+volatile uint16_t fftRingPos = 0;
+volatile bool fftConverting = false;   // a conversion was started last tick
+
+IntervalTimer fftTimer;
+
+// work buffers & tables
+int16_t fftRe[FFT_SIZE];
+int16_t fftIm[FFT_SIZE];
+int16_t fftWindow[FFT_SIZE];          // Hann, Q15
+int16_t fftCos[FFT_SIZE / 2];         // twiddles, Q15
+int16_t fftSin[FFT_SIZE / 2];
+uint16_t fftBandStart[FFT_BANDS + 1]; // first bin of each band
+uint8_t fftBandGroup[FFT_BANDS];      // which of the 7 bands it feeds
+bool fftTablesBuilt = false;
+
+
+
+
+void startFftSampler()
+{
+  if (!fftTablesBuilt)
+    fftSetup();
+  fftTablesBuilt = true;
+
+  adc->adc0->setResolution(10);
+  adc->adc0->setAveraging(1);
+  fftConverting = false;
+
+  fftTimer.priority(MSGEQ7_TIMER_PRIORITY);
+  fftTimer.begin(fftSampleISR, 1000000.0 / FFT_SAMPLE_RATE);
+}
+
+
+
+void stopFftSampler()
+{
+  fftTimer.end();
+  fftConverting = false;
+}
+
+
+
+// the sample converted since the last tick, then start the next
+void fftSampleISR()
+{
+  if (fftConverting)
+  {
+    fftRing[fftRingPos] = adc->adc0->readSingle();
+    fftRingPos = (fftRingPos + 1) & (FFT_SIZE - 1);
+  }
+  fftConverting = adc->adc0->startSingleRead(FFT_AUDIO_PIN);
+}
+
+
+
+
+// build the window, twiddle & band tables, only done once
+void fftSetup()
+{
+  for (uint16_t i = 0; i < FFT_SIZE; i++)
+    fftWindow[i] = 32767 * (0.5 - 0.5 * cos(TWO_PI * i / (FFT_SIZE - 1)));
+
+  for (uint16_t i = 0; i < FFT_SIZE / 2; i++)
+  {
+    fftCos[i] = 32767 * cos(TWO_PI * i / FFT_SIZE);
+    fftSin[i] = 32767 * sin(TWO_PI * i / FFT_SIZE);
+  }
+
+  // log spaced band edges from FFT_LOW_FREQ to nyquist,
+  // every band gets at least one bin
+  float highFreq = FFT_SAMPLE_RATE / 2.0;
+  float binWidth = (float)FFT_SAMPLE_RATE / FFT_SIZE;
+
+  for (uint16_t band = 0; band <= FFT_BANDS; band++)
+  {
+    float freq = FFT_LOW_FREQ * pow(highFreq / FFT_LOW_FREQ, (float)band / FFT_BANDS);
+    uint16_t bin = freq / binWidth;
+
+    if (band > 0 && bin <= fftBandStart[band - 1])
+      bin = fftBandStart[band - 1] + 1;
+    fftBandStart[band] = min(bin, (uint16_t)(FFT_SIZE / 2));
+  }
+
+  // group each band with the nearest MSGEQ7 band (log distance)
+  for (uint16_t band = 0; band < FFT_BANDS; band++)
+  {
+    float center = (fftBandStart[band] + fftBandStart[band + 1]) * binWidth / 2.0;
+    float best = 1e6;
+
+    for (uint8_t group = 0; group < EQ_BANDS7; group++)
+    {
+      // keep the top group's center below nyquist
+      float groupFreq = min(fftBand7Freq[group], highFreq * 0.8f);
+      float distance = fabs(log(center / groupFreq));
+      if (distance < best)
+      {
+        best = distance;
+        fftBandGroup[band] = group;
+      }
+    }
+  }
+}
+
+
+
+
+// in-place radix-2 FFT on Q15 values, scaled by 1/2 every
+// stage (1/FFT_SIZE overall) so it can't overflow
+void fft16(int16_t* re, int16_t* im)
+{
+  // bit reverse reorder
+  for (uint16_t i = 1, j = 0; i < FFT_SIZE; i++)
+  {
+    uint16_t bit = FFT_SIZE >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+
+    if (i < j)
+    {
+      int16_t t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+
+  // butterflies
+  for (uint16_t len = 2, step = FFT_SIZE / 2; len <= FFT_SIZE; len <<= 1, step >>= 1)
+  {
+    uint16_t half = len >> 1;
+
+    for (uint16_t i = 0; i < FFT_SIZE; i += len)
+    {
+      for (uint16_t k = 0; k < half; k++)
+      {
+        int32_t wr = fftCos[k * step];
+        int32_t wi = -fftSin[k * step];
+        uint16_t a = i + k;
+        uint16_t b = a + half;
+
+        int32_t tr = (re[b] * wr - im[b] * wi) >> 15;
+        int32_t ti = (re[b] * wi + im[b] * wr) >> 15;
+
+        re[b] = (re[a] - tr) >> 1;
+        im[b] = (im[a] - ti) >> 1;
+        re[a] = (re[a] + tr) >> 1;
+        im[a] = (im[a] + ti) >> 1;
+      }
+    }
+  }
+}
+
+
+
+
+// run the FFT on the newest samples and update fftBands[]
+void calcFftBands()
+{
+  uint32_t start = micros();
+
+  // copy oldest -> newest. The ISR may overwrite a sample or two
+  // while copying, which only adds a tiny glitch at the start
+  noInterrupts();
+  uint16_t pos = fftRingPos;
+  interrupts();
+
+  int32_t sum = 0;
+  for (uint16_t i = 0; i < FFT_SIZE; i++)
+  {
+    fftRe[i] = fftRing[(pos + i) & (FFT_SIZE - 1)];
+    sum += fftRe[i];
+  }
+
+  // remove the dc bias, scale 10-bit to Q15 and window
+  int16_t mean = sum >> FFT_LOG2;
+  for (uint16_t i = 0; i < FFT_SIZE; i++)
+  {
+    int32_t x = (fftRe[i] - mean) << 5;
+    fftRe[i] = (x * fftWindow[i]) >> 15;
+    fftIm[i] = 0;
+  }
+
+  fft16(fftRe, fftIm);
+
+  // peak magnitude in each band, |z| ~ max + 3/8 min
+  for (uint16_t band = 0; band < FFT_BANDS; band++)
+  {
+    uint16_t peak = 0;
+
+    for (uint16_t bin = fftBandStart[band]; bin < fftBandStart[band + 1]; bin++)
+    {
+      uint16_t re = abs(fftRe[bin]);
+      uint16_t im = abs(fftIm[bin]);
+      uint16_t mag = (re > im) ? re + ((im * 3) >> 3) : im + ((re * 3) >> 3);
+      if (mag > peak)
+        peak = mag;
+    }
+
+    uint32_t level = ((uint32_t)peak * FFT_LEVEL_SF >> 8) + FFT_BACKGROUND;
+    fftBands[band] = min(level, (uint32_t)MAX_AUDIO);
+  }
+
+  fftMicros = micros() - start;
+}
+
+
+
+
+// background, threshold & gain as getAudioData() does for the
+// 7 bands
+void scaleFftBands()
+{
+  for (uint16_t band = 0; band < FFT_BANDS; band++)
+  {
+    audio_t value = (audio_t)fftBands[band] - FFT_BACKGROUND;
+
+    if (value < minThreashold)
+      value = 0;
+    else
+      value = constrain(scaleAudio(value), 0, 1000);
+
+    fftAudio[band] = value;
+  }
+}
+
+
+
+
+// same fall speed as peaks[]
+void findFftPeaks(audio_t decay)
+{
+  for (uint16_t band = 0; band < FFT_BANDS; band++)
+  {
+    if (fftAudio[band] > fftPeaks[band])
+      fftPeaks[band] = fftAudio[band];
+    else
+      fftPeaks[band] = max(fftPeaks[band] - decay, (audio_t)0);
+  }
+}
+
+
+
+
+// spectrum from the ADC, grouped into the 7 MSGEQ7 bands
+class FftSource : public AudioSource {
+  public:
+    void begin()
+    {
+      if (!_started)
+        startFftSampler();
+      _started = true;
+    }
+
+    void end()
+    {
+      if (_started)
+        stopFftSampler();
+      _started = false;
+    }
+
+    bool read(uint16_t* bands, uint32_t* timestamp)
+    {
+      *timestamp = micros();
+      calcFftBands();
+
+      for (uint8_t band = 0; band < EQ_BANDS7; band++)
+        bands[band] = 0;
+
+      for (uint16_t band = 0; band < FFT_BANDS; band++)
+      {
+        uint8_t group = fftBandGroup[band];
+        if (fftBands[band] > bands[group])
+          bands[group] = fftBands[band];
+      }
+
+      return true;
+    }
+
+    const char* name() { return "fft"; }
+
+  private:
+    bool _started = false;
+};
@@ -0,0 +1,150 @@
+/*************************************************************
+
+   frameBuffer.h - direct access to the pixels patterns draw in
+
+   fb is a view on canvas.buffer(), attached at the start of
+   every frame (AudioPatterns::update() and
+   Effects::updateBuffer(), next to rgb24Buffer). The size is
+   known at compile time, so fb.at(x, y) and fb.row(y) inline
+   to a multiply/add, with no call per pixel.
+
+   Inner loops should take a row pointer once and walk it:
+
+     rgb24* row = fb.row(y);
+     for (uint16_t x = 0; x < fb.width(); x++)
+       row[x] += ...;
+
+   or go through a span:
+
+     for (rgb24& pixel : fb.span(y, x0, x1))
+       pixel.nscale8(sf);
+
+   The stride is the matrix width. XY() used to use kScreenWidth
+   (width - 1) so everything drawn with it slanted one pixel per
+   row. With a render scale (canvas.h) the view is attached with
+   the shift and the stride is the small buffer's width.
+
+   When the canvas is scrolling the buffer is a ring of rows
+   starting at canvas.scrollTop(). fb is attached with it and
+   canvas.scrollDown() keeps it up to date, so row(y), at() and
+   index() always mean screen rows. A row is never split by the
+   ring, so row pointers and spans still work.
+
+   Writing through fb doesn't mark tiles (canvas.h), patterns that
+   do have to call canvas.markPixel() or be untracked.
+
+   BOUNDS_CHECKING (hardware.h) checks every at(). A pixel off
+   the view goes to column or row 0 instead and the pattern is
+   dropped back to 0, as XY() used to.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+
+template <uint16_t W, uint16_t H>
+class FrameBufferView {
+  public:
+
+    // a run of pixels in one row, for range based loops
+    struct RowSpan {
+      rgb24* first;
+      rgb24* last;
+
+      rgb24* begin() { return first; }
+      rgb24* end() { return last; }
+      uint16_t size() { return last - first; }
+      rgb24& operator[](uint16_t i) { return first[i]; }
+    };
+
+
+    void attach(rgb24* buffer, uint8_t shift = 0, uint16_t top = 0)
+    {
+      _pixels = buffer;
+      _shift = shift;
+      _top = top;
+    }
+
+    void scrollTo(uint16_t top)
+    {
+      _top = top;
+    }
+
+
+    static constexpr uint16_t maxWidth() { return W; }
+    static constexpr uint16_t maxHeight() { return H; }
+    uint16_t width() { return W >> _shift; }
+    uint16_t height() { return H >> _shift; }
+    uint16_t stride() { return W >> _shift; }
+    rgb24* pixels() { return _pixels; }
+
+
+    rgb24* row(uint16_t y)
+    {
+      return _pixels + (uint32_t)ringRow(y) * stride();
+    }
+
+
+    uint32_t index(uint16_t x, uint16_t y)
+    {
+#ifdef BOUNDS_CHECKING
+      // like XY() did, draw on the edge and give up on the pattern
+      if (x >= width() || y >= height())
+      {
+        Serial.print("fb out of bounds "); Serial.print(x);
+        Serial.print(", "); Serial.println(y);
+        if (x >= width())
+          x = 0;
+        if (y >= height())
+          y = 0;
+        pattern = 0;
+      }
+#endif
+      return (uint32_t)ringRow(y) * stride() + x;
+    }
+
+
+    rgb24& at(uint16_t x, uint16_t y)
+    {
+      return _pixels[index(x, y)];
+    }
+
+
+    // pixels x0 up to, not including, x1
+    RowSpan span(uint16_t y, uint16_t x0, uint16_t x1)
+    {
+      rgb24* r = row(y);
+      return { r + x0, r + x1 };
+    }
+
+    RowSpan span(uint16_t y)
+    {
+      return span(y, 0, width());
+    }
+
+
+  private:
+    rgb24* _pixels = nullptr;
+    uint8_t _shift = 0;
+    uint16_t _top = 0;
+
+
+    uint16_t ringRow(uint16_t y)
+    {
+      if (_top > 0)
+      {
+        y += _top;
+        if (y >= H)
+          y -= H;
+      }
+      return y;
+    }
+};
+
+
+
+FrameBufferView<kMatrixWidth, kMatrixHeight> fb;
@@ -0,0 +1,130 @@
+/*************************************************************
+
+   frameClock.h - one time step for everything in a frame
+
+   tickFrameClock() is called once at the start of every frame
+   (AudioPatterns::update()). Patterns and the audio smoothing
+   then use frameTime / frameDt instead of reading the clock
+   themselves or assuming every frame is the same length, so
+   speeding up a pattern doesn't change how it looks.
+
+   Rates are given per second, or per FRAME_REF_MICROS for the
+   values that were tuned per frame (about 100 fps with the
+   default delayVal).
+
+   frameSteps()  - whole steps to move at a rate per second, the
+                   fraction is carried to the next frame. The
+                   int32_t version takes rates that can go
+                   negative, the carry keeps its sign
+   frameDecay()  - a per reference frame decay factor (0.95)
+                   scaled to this frame
+   frameDecayQ16() - the same in 16.16 fixed point, no powf()
+
+   frameMillis is the frame time in mS, the sum of every frameDt
+   so far. Anything timed in mS (beatDetect.h) uses it instead of
+   millis() so it follows fixedFrameDt too.
+
+   fixedFrameDt can be set to make every frame the same length
+   (the benchmark uses it so runs are repeatable).
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#define FRAME_REF_MICROS    10000     // frame length the old per frame values assumed
+#define FRAME_MAX_MICROS    100000    // longest step, so a stall doesn't jump
+
+
+// prototypes
+void tickFrameClock();
+uint32_t frameSteps(uint32_t ratePerSec, uint32_t& carry);
+int32_t frameSteps(int32_t ratePerSec, int32_t& carry);
+float frameDecay(float factor);
+uint32_t frameDecayQ16(uint32_t factorQ16);
+
+
+uint32_t frameTime = 0;             // micros() at the start of this frame
+uint32_t frameDt = FRAME_REF_MICROS;// uS since the last frame
+uint32_t fixedFrameDt = 0;          // if set, used instead of the real dt
+uint32_t lastFrameTime = 0;
+uint32_t frameMillis = 0;           // frame time in mS, sum of frameDt
+uint32_t frameMillisCarry = 0;      // uS not yet in frameMillis
+
+
+
+
+void tickFrameClock()
+{
+  frameTime = micros();
+
+  if (fixedFrameDt > 0)
+    frameDt = fixedFrameDt;
+  else if (lastFrameTime == 0)
+    frameDt = FRAME_REF_MICROS;
+  else
+    frameDt = min(frameTime - lastFrameTime, (uint32_t)FRAME_MAX_MICROS);
+
+  lastFrameTime = frameTime;
+
+  frameMillisCarry += frameDt;
+  frameMillis += frameMillisCarry / 1000;
+  frameMillisCarry %= 1000;
+}
+
+
+
+
+uint32_t frameSteps(uint32_t ratePerSec, uint32_t& carry)
+{
+  carry += ratePerSec * frameDt;
+  uint32_t steps = carry / 1000000;
+  carry -= steps * 1000000;
+  return steps;
+}
+
+
+
+
+// rounds toward zero, so the carry has the sign of the rate
+int32_t frameSteps(int32_t ratePerSec, int32_t& carry)
+{
+  carry += ratePerSec * (int32_t)frameDt;
+  int32_t steps = carry / 1000000;
+  carry -= steps * 1000000;
+  return steps;
+}
+
+
+
+
+float frameDecay(float factor)
+{
+  if (frameDt == FRAME_REF_MICROS)
+    return factor;
+  return powf(factor, (float)frameDt / FRAME_REF_MICROS);
+}
+
+
+
+
+// factorQ16 below 1.0 (65536). Whole reference frames are
+// multiplied in, the part frame left over is taken as a straight
+// line from 1 to the factor
+uint32_t frameDecayQ16(uint32_t factorQ16)
+{
+  uint32_t result = 65536;
+
+  for (uint32_t dt = frameDt; dt >= FRAME_REF_MICROS; dt -= FRAME_REF_MICROS)
+    result = (result * factorQ16) >> 16;
+
+  uint32_t part = frameDt % FRAME_REF_MICROS;
+  if (part == 0)
+    return result;
+
+  uint32_t partQ16 = 65536 - (65536 - factorQ16) * part / FRAME_REF_MICROS;
+  return (result * partQ16) >> 16;
+}
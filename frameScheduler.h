@@ -0,0 +1,113 @@
+/*************************************************************
+
+   frameScheduler.h - paces the frames in loop()
+
+   Each pattern has a target frame time (patternFrameMs[] in
+   AudioPatterns.h, which replaces the delays that used to be
+   inside the patterns) and delayVal is added to it as the
+   overall "slow things down" setting. After a frame is drawn
+   only what's left of the frame time is spent waiting, and it's
+   spent polling serial, DMX and the IR remote, so commands are
+   handled within a few uS instead of waiting behind a delay.
+   They're polled at least once a frame, even when a frame runs
+   over.
+
+   frameMicros is the time the last frame took to draw, and
+   frameOverruns counts frames that took longer than their
+   target. The draw time also drives the quality level
+   (quality.h).
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+// prototypes
+void beginFrame();
+void endFrame();
+void pollInputs();
+uint32_t framePeriod();
+void printFrameStats();
+
+
+uint32_t frameStart = 0;            // micros() at the start of the frame
+uint32_t frameMicros = 0;           // time taken to draw the last frame
+uint32_t frameOverruns = 0;         // frames that took longer than the target
+
+
+
+
+void beginFrame()
+{
+  frameStart = micros();
+}
+
+
+
+
+// wait out the rest of the frame, handling inputs meanwhile
+void endFrame()
+{
+  frameMicros = micros() - frameStart;
+
+  uint32_t period = framePeriod();
+  if (frameMicros > period)
+    frameOverruns++;
+
+  checkQuality(frameMicros, period);
+
+  do
+  {
+    pollInputs();
+  } while (micros() - frameStart < period);
+}
+
+
+
+
+// target frame time for the current pattern in uS
+uint32_t framePeriod()
+{
+  uint32_t ms = (pattern < numPatterns) ? patternFrameMs[pattern] : 0;
+  return (ms + delayVal) * 1000;
+}
+
+
+
+
+void pollInputs()
+{
+  // check serial port for data & handle
+#ifdef USE_SERIAL
+  checkSerial();
+#endif
+
+  // check for dmx change
+#ifdef USE_DMX
+  checkDMX();
+#endif
+
+  // check for pending ir commands
+#ifdef USE_IR_REMOTE
+  checkIRRemote();
+#endif
+}
+
+
+
+
+void printFrameStats()
+{
+  Serial.print("frame target : "); Serial.print(framePeriod()); Serial.println(" uS");
+  Serial.print("frame time   : "); Serial.print(frameMicros); Serial.println(" uS");
+  Serial.print("overruns     : "); Serial.println(frameOverruns);
+  Serial.print("quality      : "); Serial.print(quality);
+  adaptiveQuality ? Serial.println(" (adaptive)") : Serial.println(" (fixed)");
+  Serial.print("over budget  : "); Serial.println(qualityOverruns);
+  Serial.print("steps down   : "); Serial.println(qualityChanges);
+  Serial.print("presented    : "); Serial.println(canvas.presented);
+  Serial.print("skipped      : "); Serial.println(canvas.skipped);
+}
@@ -0,0 +1,54 @@
+/*************************************************************
+
+   ADC.h - host stand-in for the Teensy ADC library, the single
+   read calls of one module. The conversion is "done" as soon as
+   it's started, readSingle() returns analogRead() of the pin
+   startSingleRead() was given.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include "Arduino.h"
+
+
+class ADC_Module {
+  public:
+    void setResolution(uint8_t) {}
+    void setAveraging(uint8_t) {}
+
+    bool startSingleRead(uint8_t pin)
+    {
+      _value = analogRead(pin);
+      _complete = true;
+      return true;
+    }
+
+    bool isComplete() { return _complete; }
+
+    int readSingle()
+    {
+      _complete = false;
+      return _value;
+    }
+
+  private:
+    int _value = 0;
+    bool _complete = false;
+};
+
+
+
+class ADC {
+  public:
+    ADC() : adc0(&_module0) {}
+
+    ADC_Module* const adc0;
+
+  private:
+    ADC_Module _module0;
+};
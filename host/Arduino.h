@@ -0,0 +1,212 @@
+/*************************************************************
+
+   Arduino.h - host stand-in for the Teensy Arduino core
+
+   Just enough of the core for the sketch to build and run on a
+   desktop (HOST_BUILD, see hardware.h and CMakeLists.txt).
+
+   Time is virtual by default: micros() / millis() only move when
+   the host advances them (hostAdvance(), delay()), and the
+   IntervalTimer callbacks are run at their period as it does, so
+   a run is the same every time. hostRealClock(true) switches to
+   the wall clock for timing (the benchmark), delay() then skips
+   ahead instead of sleeping and the timers don't run.
+
+   analogRead() returns what hostAnalogInput() is set to, which is
+   how the host feeds audio to the sampler and the FFT.
+
+   Serial writes to stdout (hostSerialOutput() to change it) and
+   reads what hostSerialType() has queued, nothing by default.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <type_traits>
+
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+
+#define LOW         0
+#define HIGH        1
+#define INPUT       0
+#define OUTPUT      1
+
+#define DEC         10
+#define HEX         16
+#define BIN         2
+
+#define PI          3.1415926535897932384626433832795
+#define HALF_PI     1.5707963267948966192313216916398
+#define TWO_PI      6.283185307179586476925286766559
+
+// the analog pins hardware.h uses, numbered as on a Teensy 4.1
+#define A0          14
+#define A5          19
+#define A9          23
+#define A17         41
+
+#define DMAMEM
+#define EXTMEM
+#define PROGMEM
+#define FASTRUN
+#define FLASHMEM
+
+#define radians(deg)            ((deg) * 0.017453292519943295)
+#define degrees(rad)            ((rad) * 57.295779513082320876)
+#define constrain(amt, lo, hi)  ((amt) < (lo) ? (lo) : ((amt) > (hi) ? (hi) : (amt)))
+
+
+
+// the core's min / max take mixed types
+template <class A, class B>
+typename std::common_type<A, B>::type min(A a, B b)
+{
+  return (b < a) ? b : a;
+}
+
+template <class A, class B>
+typename std::common_type<A, B>::type max(A a, B b)
+{
+  return (a < b) ? b : a;
+}
+
+
+template <class A, class B, class C, class D, class E>
+A map(A x, B inMin, C inMax, D outMin, E outMax)
+{
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+
+
+// time
+uint32_t micros();
+uint32_t millis();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+
+// pins, nothing is connected
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline void digitalWriteFast(uint8_t, uint8_t) {}
+inline uint8_t digitalRead(uint8_t) { return LOW; }
+int analogRead(uint8_t pin);
+inline void analogReadAveraging(uint32_t) {}
+inline void analogReadResolution(uint32_t) {}
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+inline void yield() {}
+
+inline void* extmem_malloc(size_t size) { return malloc(size); }
+inline void extmem_free(void* ptr) { free(ptr); }
+
+
+// Arduino random(), its own generator so FastLED's doesn't move it
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(uint32_t seed);
+
+
+
+class String {
+  public:
+    String(const char* s = "") : _s(s) {}
+    String(const std::string& s) : _s(s) {}
+
+    const char* c_str() const { return _s.c_str(); }
+    uint32_t length() const { return _s.length(); }
+
+    bool operator==(const char* s) const { return _s == s; }
+    String operator+(const char* s) const { return String(_s + s); }
+
+  private:
+    std::string _s;
+};
+
+
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(const char* s, size_t count) = 0;
+
+    size_t print(const char* s) { return write(s, strlen(s)); }
+    size_t print(const String& s) { return print(s.c_str()); }
+    size_t print(char c) { return write(&c, 1); }
+    size_t print(int n, int base = DEC) { return printNumber((long long)n, base); }
+    size_t print(unsigned int n, int base = DEC) { return printNumber((unsigned long long)n, base); }
+    size_t print(long n, int base = DEC) { return printNumber((long long)n, base); }
+    size_t print(unsigned long n, int base = DEC) { return printNumber((unsigned long long)n, base); }
+    size_t print(long long n, int base = DEC) { return printNumber(n, base); }
+    size_t print(unsigned long long n, int base = DEC) { return printNumber(n, base); }
+    size_t print(double n, int digits = 2);
+
+    size_t println() { return print("\r\n"); }
+
+    template <class T>
+    size_t println(T value) { return print(value) + println(); }
+
+    template <class T>
+    size_t println(T value, int format) { return print(value, format) + println(); }
+
+  private:
+    size_t printNumber(long long n, int base);
+    size_t printNumber(unsigned long long n, int base);
+};
+
+
+
+class HardwareSerial : public Print {
+  public:
+    void begin(uint32_t) {}
+    int available();
+    int read();
+    int peek();
+    void flush();
+    size_t write(const char* s, size_t count);
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+
+
+// the callback runs at its period as the virtual clock is advanced
+class IntervalTimer {
+  public:
+    ~IntervalTimer() { end(); }
+
+    bool begin(void (*callback)(), uint32_t microseconds);
+    bool begin(void (*callback)(), int microseconds) { return begin(callback, (uint32_t)microseconds); }
+    bool begin(void (*callback)(), float microseconds) { return begin(callback, (uint32_t)microseconds); }
+    bool begin(void (*callback)(), double microseconds) { return begin(callback, (uint32_t)microseconds); }
+    void end();
+    void priority(uint8_t) {}
+
+  private:
+    int8_t _slot = -1;
+};
+
+
+
+// host controls, host/hostCore.cpp
+void hostRealClock(bool on);
+void hostAdvance(uint32_t us);
+void hostAnalogInput(int (*read)(uint8_t pin));
+void hostSerialOutput(FILE* out);
+void hostSerialType(const char* text);
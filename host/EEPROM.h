@@ -0,0 +1,59 @@
+/*************************************************************
+
+   EEPROM.h - host stand-in, 4K of RAM that reads 0xFF until
+   written, the same as a blank Teensy 4.1. Nothing is kept
+   between runs.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include "Arduino.h"
+
+
+#define HOST_EEPROM_SIZE  4284
+
+
+class EEPROMClass {
+  public:
+    EEPROMClass() { memset(_data, 0xFF, sizeof(_data)); }
+
+    void begin() {}
+    uint16_t length() { return HOST_EEPROM_SIZE; }
+
+    uint8_t read(int addr) { return (addr >= 0 && addr < HOST_EEPROM_SIZE) ? _data[addr] : 0xFF; }
+
+    void write(int addr, uint8_t value)
+    {
+      if (addr >= 0 && addr < HOST_EEPROM_SIZE)
+        _data[addr] = value;
+    }
+
+    template <class T>
+    T& get(int addr, T& t)
+    {
+      uint8_t* p = (uint8_t*)&t;
+      for (size_t i = 0; i < sizeof(T); i++)
+        p[i] = read(addr + i);
+      return t;
+    }
+
+    template <class T>
+    const T& put(int addr, const T& t)
+    {
+      const uint8_t* p = (const uint8_t*)&t;
+      for (size_t i = 0; i < sizeof(T); i++)
+        write(addr + i, p[i]);
+      return t;
+    }
+
+  private:
+    uint8_t _data[HOST_EEPROM_SIZE];
+};
+
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,220 @@
+/*************************************************************
+
+   FastLED.h - host stand-in for the parts of FastLED the sketch
+   uses
+
+   The 8-bit math is FastLED's C fallback code, same results as on
+   the Teensy (scale8() with FASTLED_SCALE8_FIXED, which the
+   palettes and fastMath.h assume). The noise is a Perlin noise of
+   the same range and feel, not FastLED's exact values.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include "Arduino.h"
+
+
+#define FASTLED_VERSION       3004000
+#define FASTLED_SCALE8_FIXED  1
+
+
+typedef uint8_t fract8;
+typedef uint16_t fract16;
+typedef uint16_t accum88;
+
+
+
+inline uint8_t scale8(uint8_t i, fract8 scale)
+{
+  return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;
+}
+
+
+inline uint16_t scale16(uint16_t i, fract16 scale)
+{
+  return ((uint32_t)i * (1 + (uint32_t)scale)) >> 16;
+}
+
+
+inline uint8_t qadd8(uint8_t i, uint8_t j)
+{
+  uint16_t t = i + j;
+  return (t > 255) ? 255 : t;
+}
+
+
+inline uint8_t qsub8(uint8_t i, uint8_t j)
+{
+  int16_t t = i - j;
+  return (t < 0) ? 0 : t;
+}
+
+
+
+inline uint8_t sin8(uint8_t theta)
+{
+  static const uint8_t interleave[] = {0, 49, 49, 41, 90, 27, 117, 10};
+
+  uint8_t offset = theta;
+  if (theta & 0x40)
+    offset = 255 - offset;
+  offset &= 0x3F;
+
+  uint8_t secoffset = offset & 0x0F;
+  if (theta & 0x40)
+    secoffset++;
+
+  uint8_t section = offset >> 4;
+  uint8_t b = interleave[section * 2];
+  uint8_t m16 = interleave[section * 2 + 1];
+  uint8_t mx = (m16 * secoffset) >> 4;
+
+  int8_t y = mx + b;
+  if (theta & 0x80)
+    y = -y;
+  return y + 128;
+}
+
+
+inline uint8_t cos8(uint8_t theta)
+{
+  return sin8(theta + 64);
+}
+
+
+inline int16_t sin16(uint16_t theta)
+{
+  static const uint16_t base[] = {0, 6393, 12539, 18204, 23170, 27245, 30273, 32137};
+  static const uint8_t slope[] = {49, 48, 44, 38, 31, 23, 14, 4};
+
+  uint16_t offset = (theta & 0x3FFF) >> 3;
+  if (theta & 0x4000)
+    offset = 2047 - offset;
+
+  uint8_t section = offset / 256;
+  uint8_t secoffset8 = (uint8_t)offset / 2;
+  int16_t y = slope[section] * secoffset8 + base[section];
+
+  if (theta & 0x8000)
+    y = -y;
+  return y;
+}
+
+
+inline int16_t cos16(uint16_t theta)
+{
+  return sin16(theta + 16384);
+}
+
+
+inline uint8_t triwave8(uint8_t in)
+{
+  if (in & 0x80)
+    in = 255 - in;
+  return in << 1;
+}
+
+
+inline uint8_t map8(uint8_t in, uint8_t rangeStart, uint8_t rangeEnd)
+{
+  return scale8(in, rangeEnd - rangeStart) + rangeStart;
+}
+
+
+
+// beats, from millis() like FastLED
+inline uint16_t beat88(accum88 bpm88, uint32_t timebase = 0)
+{
+  return ((millis() - timebase) * bpm88 * 280) >> 16;
+}
+
+
+inline uint16_t beat16(accum88 bpm, uint32_t timebase = 0)
+{
+  if (bpm < 256)
+    bpm <<= 8;
+  return beat88(bpm, timebase);
+}
+
+
+inline uint8_t beat8(accum88 bpm, uint32_t timebase = 0)
+{
+  return beat16(bpm, timebase) >> 8;
+}
+
+
+inline uint8_t beatsin8(accum88 bpm, uint8_t lowest = 0, uint8_t highest = 255,
+                        uint32_t timebase = 0, uint8_t phaseOffset = 0)
+{
+  uint8_t beatsin = sin8(beat8(bpm, timebase) + phaseOffset);
+  return lowest + scale8(beatsin, highest - lowest);
+}
+
+
+
+// FastLED's 16-bit LCG
+extern uint16_t rand16seed;
+
+inline uint16_t random16()
+{
+  rand16seed = (rand16seed * 2053) + 13849;
+  return rand16seed;
+}
+
+
+inline uint8_t random8()
+{
+  random16();
+  return (uint8_t)rand16seed + (uint8_t)(rand16seed >> 8);
+}
+
+
+inline uint8_t random8(uint8_t lim)
+{
+  return (random8() * lim) >> 8;
+}
+
+
+inline void random16_set_seed(uint16_t seed)
+{
+  rand16seed = seed;
+}
+
+
+
+// x, y, z are 16.16 fixed point, returns 0..65535
+uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z);
+
+// x, y, z are 8.8 fixed point, returns 0..255
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z);
+
+
+
+// EVERY_N_MILLIS(n) { ... }
+class CEveryNMillis {
+  public:
+    CEveryNMillis(uint32_t period) : _period(period), _prevTrigger(millis()) {}
+
+    bool ready()
+    {
+      uint32_t now = millis();
+      if (now - _prevTrigger < _period)
+        return false;
+      _prevTrigger = now;
+      return true;
+    }
+
+  private:
+    uint32_t _period;
+    uint32_t _prevTrigger;
+};
+
+#define FL_CONCAT2(a, b)      a##b
+#define FL_CONCAT(a, b)       FL_CONCAT2(a, b)
+#define EVERY_N_MILLIS(n)     static CEveryNMillis FL_CONCAT(everyN, __LINE__)(n); \
+                              if (FL_CONCAT(everyN, __LINE__).ready())
@@ -0,0 +1,11 @@
+/*************************************************************
+
+   MatrixHardware_Teensy4_ShieldV5.h - host stand-in, the shield
+   pin mapping means nothing off the Teensy
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
@@ -0,0 +1,44 @@
+/*************************************************************
+
+   PrintValues.h - host stand-in for the name / value debug
+   prints, written to Serial the same way
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include "Arduino.h"
+
+
+inline void printValue()
+{
+  Serial.println();
+}
+
+
+inline void printValue(const char* text)
+{
+  Serial.println(text);
+}
+
+
+template <class T>
+void printValue(const char* name, T value)
+{
+  Serial.print(name);
+  Serial.print(" ");
+  Serial.println(value);
+}
+
+
+template <class T>
+void printHexValue(const char* name, T value)
+{
+  Serial.print(name);
+  Serial.print(" 0x");
+  Serial.println(value, HEX);
+}
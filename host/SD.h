@@ -0,0 +1,88 @@
+/*************************************************************
+
+   SD.h - host stand-in, the "card" is the current directory (or
+   the one given to hostSdRoot()) so WavSource can play a WAV
+   file off the disk
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include "Arduino.h"
+
+
+#define BUILTIN_SDCARD  254
+#define FILE_READ       0
+
+
+class File {
+  public:
+    File(FILE* file = nullptr) : _file(file) {}
+
+    operator bool() { return _file != nullptr; }
+
+    int read(void* buf, size_t count) { return _file ? fread(buf, 1, count, _file) : 0; }
+
+    int read()
+    {
+      uint8_t b;
+      return (read(&b, 1) == 1) ? b : -1;
+    }
+
+    bool seek(uint32_t pos) { return _file && fseek(_file, pos, SEEK_SET) == 0; }
+    uint32_t position() { return _file ? ftell(_file) : 0; }
+
+    uint32_t size()
+    {
+      if (!_file)
+        return 0;
+      long pos = ftell(_file);
+      fseek(_file, 0, SEEK_END);
+      long end = ftell(_file);
+      fseek(_file, pos, SEEK_SET);
+      return end;
+    }
+
+    int available() { return size() - position(); }
+
+    void close()
+    {
+      if (_file)
+        fclose(_file);
+      _file = nullptr;
+    }
+
+  private:
+    FILE* _file;
+};
+
+
+
+class SDClass {
+  public:
+    bool begin(uint8_t) { return true; }
+
+    File open(const char* name, uint8_t = FILE_READ)
+    {
+      std::string path = _root + "/" + name;
+      return File(fopen(path.c_str(), "rb"));
+    }
+
+    void setRoot(const char* root) { _root = root; }
+
+  private:
+    std::string _root = ".";
+};
+
+
+extern SDClass SD;
+
+
+inline void hostSdRoot(const char* root)
+{
+  SD.setRoot(root);
+}
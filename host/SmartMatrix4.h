@@ -0,0 +1,159 @@
+/*************************************************************
+
+   SmartMatrix4.h - host stand-in for the SmartMatrix library
+
+   The background layer is two plain buffers, swapBuffers()
+   swaps them at once (there's no refresh to wait for) and the
+   front one is what the panel would show, frontBuffer() is read
+   by the host to write PPM files. matrix holds the brightness
+   and rotation, nothing is driven.
+
+   rgb24 has the += (qadd8) and nscale8() the sketch uses on it.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include "FastLED.h"
+
+#include <vector>
+
+
+struct rgb24 {
+  rgb24() : red(0), green(0), blue(0) {}
+  rgb24(uint8_t r, uint8_t g, uint8_t b) : red(r), green(g), blue(b) {}
+
+  rgb24& operator+=(const rgb24& rhs)
+  {
+    red = qadd8(red, rhs.red);
+    green = qadd8(green, rhs.green);
+    blue = qadd8(blue, rhs.blue);
+    return *this;
+  }
+
+  rgb24& nscale8(uint8_t scale)
+  {
+    red = scale8(red, scale);
+    green = scale8(green, scale);
+    blue = scale8(blue, scale);
+    return *this;
+  }
+
+  uint8_t red;
+  uint8_t green;
+  uint8_t blue;
+};
+
+
+enum rotationDegrees {
+  rotation0,
+  rotation90,
+  rotation180,
+  rotation270
+};
+
+
+#define SMARTMATRIX_HUB75_32ROW_MOD16SCAN           0
+#define SMARTMATRIX_HUB75_64ROW_MOD32SCAN           1
+
+#define SMARTMATRIX_OPTIONS_NONE                    0
+#define SMARTMATRIX_OPTIONS_C_SHAPE_STACKING        (1 << 0)
+#define SMARTMATRIX_OPTIONS_BOTTOM_TO_TOP_STACKING  (1 << 1)
+
+#define SM_BACKGROUND_OPTIONS_NONE                  0
+
+
+
+class SMLayerBackground {
+  public:
+    SMLayerBackground(uint16_t width, uint16_t height) :
+      _width(width), _height(height),
+      _front(width * height), _back(width * height) {}
+
+    rgb24* backBuffer() { return _back.data(); }
+
+    void swapBuffers(bool copy = true)
+    {
+      _front.swap(_back);
+      if (copy)
+        _back = _front;
+      _swaps++;
+    }
+
+    bool isSwapPending() { return false; }
+    void enableColorCorrection(bool) {}
+
+    // host only
+    const rgb24* frontBuffer() { return _front.data(); }
+    uint32_t swaps() { return _swaps; }
+    uint16_t width() { return _width; }
+    uint16_t height() { return _height; }
+
+  private:
+    uint16_t _width;
+    uint16_t _height;
+    std::vector<rgb24> _front;
+    std::vector<rgb24> _back;
+    uint32_t _swaps = 0;
+};
+
+
+
+class SmartMatrixHub75 {
+  public:
+    SmartMatrixHub75(uint16_t width, uint16_t height) : _width(width), _height(height) {}
+
+    void addLayer(SMLayerBackground* layer) { _layer = layer; }
+    void begin() {}
+    void setRotation(rotationDegrees rotation) { _rotation = rotation; }
+    void setBrightness(uint8_t brightness) { _brightness = brightness; }
+
+    uint16_t getScreenWidth()
+    {
+      return (_rotation == rotation90 || _rotation == rotation270) ? _height : _width;
+    }
+
+    uint16_t getScreenHeight()
+    {
+      return (_rotation == rotation90 || _rotation == rotation270) ? _width : _height;
+    }
+
+    // prints the swaps per second once a second, like the library
+    void countFPS()
+    {
+      if (_layer == nullptr)
+        return;
+
+      if (millis() - _fpsStart >= 1000)
+      {
+        Serial.print("Loops last second:");
+        Serial.println(_layer->swaps() - _fpsSwaps);
+        _fpsStart = millis();
+        _fpsSwaps = _layer->swaps();
+      }
+    }
+
+    // host only
+    uint8_t brightness() { return _brightness; }
+
+  private:
+    uint16_t _width;
+    uint16_t _height;
+    SMLayerBackground* _layer = nullptr;
+    rotationDegrees _rotation = rotation0;
+    uint8_t _brightness = 255;
+    uint32_t _fpsStart = 0;
+    uint32_t _fpsSwaps = 0;
+};
+
+
+
+#define SMARTMATRIX_ALLOCATE_BUFFERS(name, width, height, refreshDepth, dmaRows, panelType, options) \
+  SmartMatrixHub75 name(width, height)
+
+#define SMARTMATRIX_ALLOCATE_BACKGROUND_LAYER(name, width, height, colorDepth, options) \
+  SMLayerBackground name(width, height)
@@ -0,0 +1,196 @@
+/*************************************************************
+
+   auroraBench.cpp - the pattern benchmark (benchmark.h) on every
+   display, with the baseline kept in a file
+
+     auroraBench -s         run all displays, save as the baseline
+     auroraBench            run again, print the change from it
+     auroraBench -d lil     just one display
+
+   -d display    big, lil, cabinet or xlights, all by default
+   -n frames     frames per pattern, at most 100 (100)
+   -b file       baseline file (bench_baseline.txt)
+   -s            save this run as the baseline
+
+   Each pattern is timed on the wall clock with the replay audio
+   and a fixed frame time, like the 'B' serial command on the
+   Teensy. The baseline is a text file, one pattern per line:
+
+     display pattern mean p50 p99 worst
+
+   so two of them can be diffed as well. Patterns missing from
+   the baseline just show no delta.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#include "hostDisplay.h"
+
+#include <map>
+#include <unistd.h>
+
+
+struct Options {
+  const char* display = nullptr;
+  uint16_t frames = 100;
+  const char* baseline = "bench_baseline.txt";
+  bool save = false;
+};
+
+
+// mean frame time by "display pattern"
+typedef std::map<std::string, uint32_t> Baseline;
+
+
+
+
+bool loadBaseline(const char* name, Baseline& baseline)
+{
+  FILE* in = fopen(name, "r");
+  if (in == nullptr)
+    return false;
+
+  char line[160];
+  while (fgets(line, sizeof(line), in))
+  {
+    char display[32], pattern[64];
+    unsigned long mean;
+
+    if (line[0] == '#' || sscanf(line, "%31s %63s %lu", display, pattern, &mean) != 3)
+      continue;
+    baseline[std::string(display) + " " + pattern] = mean;
+  }
+
+  fclose(in);
+  return true;
+}
+
+
+
+
+void printDelta(const Baseline& baseline, const std::string& key, uint32_t mean)
+{
+  auto entry = baseline.find(key);
+  if (entry == baseline.end() || entry->second == 0)
+  {
+    printf("\n");
+    return;
+  }
+
+  int32_t delta = (int32_t)mean - (int32_t)entry->second;
+  printf(" %+6ld%%\n", (long)delta * 100 / (long)entry->second);
+}
+
+
+
+
+// runs every pattern on one display, adds the lines for the
+// baseline file to results
+void benchDisplay(HostDisplay* display, const Options& options,
+                  const Baseline& baseline, std::string& results)
+{
+  // setup() prints a lot and waits for things, neither matters here
+  hostSerialOutput(nullptr);
+  display->setup();
+  hostRealClock(true);
+
+  printf("\nbenchmark: %s  %u x %u  frames: %u\n", display->displayName(),
+         display->width(), display->height(), options.frames);
+  printf("pattern             mean     p50     p99   worst   delta\n");
+
+  uint64_t total = 0;
+  display->beginBenchmark();
+
+  for (uint8_t p = 1; p < display->numPatterns(); p++)
+  {
+    HostBenchResult result;
+    if (!display->benchPattern(p, options.frames, result))
+      continue;
+
+    printf("%-16s %7lu %7lu %7lu %7lu", display->patternName(p),
+           (unsigned long)result.mean, (unsigned long)result.p50,
+           (unsigned long)result.p99, (unsigned long)result.worst);
+    printDelta(baseline, std::string(display->name) + " " + display->patternName(p), result.mean);
+
+    char line[160];
+    snprintf(line, sizeof(line), "%s %s %lu %lu %lu %lu\n", display->name,
+             display->patternName(p), (unsigned long)result.mean,
+             (unsigned long)result.p50, (unsigned long)result.p99,
+             (unsigned long)result.worst);
+    results += line;
+    total += result.mean;
+  }
+
+  display->endBenchmark();
+  hostRealClock(false);
+
+  printf("%-16s %7lu", "total", (unsigned long)total);
+  printDelta(baseline, std::string(display->name) + " total", total);
+
+  char line[80];
+  snprintf(line, sizeof(line), "%s total %lu 0 0 0\n", display->name, (unsigned long)total);
+  results += line;
+}
+
+
+
+
+int usage()
+{
+  fprintf(stderr, "usage: auroraBench [-d display] [-n frames] [-b baseline] [-s]\n");
+  return 2;
+}
+
+
+int main(int argc, char** argv)
+{
+  Options options;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "d:n:b:s")) != -1)
+  {
+    switch (opt)
+    {
+      case 'd': options.display = optarg; break;
+      case 'n': options.frames = constrain(atoi(optarg), 1, 100); break;
+      case 'b': options.baseline = optarg; break;
+      case 's': options.save = true; break;
+      default: return usage();
+    }
+  }
+
+  if (options.display && HostDisplay::find(options.display) == nullptr)
+  {
+    fprintf(stderr, "no display %s\n", options.display);
+    return 2;
+  }
+
+  Baseline baseline;
+  if (loadBaseline(options.baseline, baseline))
+    printf("comparing with %s\n", options.baseline);
+  else if (!options.save)
+    printf("no baseline %s, use -s to save this run\n", options.baseline);
+
+  std::string results = "# auroraBench, frame times in uS: display pattern mean p50 p99 worst\n";
+  for (HostDisplay* d = HostDisplay::first; d; d = d->next)
+  {
+    if (options.display == nullptr || strcmp(options.display, d->name) == 0)
+      benchDisplay(d, options, baseline, results);
+  }
+
+  if (options.save)
+  {
+    FILE* out = fopen(options.baseline, "w");
+    if (out == nullptr || fputs(results.c_str(), out) < 0)
+    {
+      fprintf(stderr, "can't write %s\n", options.baseline);
+      return 1;
+    }
+    fclose(out);
+    printf("\nbaseline saved to %s\n", options.baseline);
+  }
+
+  return 0;
+}
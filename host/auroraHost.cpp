@@ -0,0 +1,204 @@
+/*************************************************************
+
+   auroraHost.cpp - runs a pattern on the desktop and writes the
+   frames out as PPM images
+
+     auroraHost -d lil -p 12 -n 200 -o frames/f%04d.ppm
+     auroraHost -d big -p 5 -n 600 -o - | ffmpeg -f image2pipe -i - out.mp4
+
+   -d display    big, lil, cabinet or xlights (hardware.h)
+   -p pattern    pattern number, or "all" to run each in turn
+   -n frames     frames to run for each pattern (100)
+   -a source     audio source, replay (default), sim, msgeq7, wav
+   -s dir        where the wav source finds audio.wav (.)
+   -o name       PPM file for each frame, %d is the frame number,
+                 "-" writes them all to stdout
+   -e n          only write every n-th frame
+   -q            no Serial output
+   -l            list the displays and patterns
+
+   The clock is virtual (host/Arduino.h), each frame moves it on
+   by the pattern's target frame time, so the frames are the
+   same on every run.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#include "hostDisplay.h"
+
+#include <unistd.h>
+
+
+struct Options {
+  const char* display = "big";
+  const char* pattern = "1";
+  uint32_t frames = 100;
+  const char* source = "replay";
+  const char* output = nullptr;
+  uint32_t every = 1;
+  bool quiet = false;
+};
+
+
+
+
+void listDisplays()
+{
+  for (HostDisplay* d = HostDisplay::first; d; d = d->next)
+    printf("%-8s %s, %u x %u\n", d->name, d->displayName(), d->width(), d->height());
+}
+
+
+// patterns are only known after setup()
+void listPatterns(HostDisplay* display)
+{
+  for (uint8_t p = 0; p < display->numPatterns(); p++)
+    printf("%3u  %s\n", p, display->patternName(p));
+}
+
+
+
+
+bool writePPM(FILE* out, HostDisplay* display)
+{
+  uint16_t width = display->width();
+  uint16_t height = display->height();
+  const rgb24* pixels = display->pixels();
+  uint8_t brightness = display->brightness();
+
+  fprintf(out, "P6\n%u %u\n255\n", width, height);
+  for (uint32_t i = 0; i < (uint32_t)width * height; i++)
+  {
+    uint8_t rgb[3] = {
+      scale8(pixels[i].red, brightness),
+      scale8(pixels[i].green, brightness),
+      scale8(pixels[i].blue, brightness)
+    };
+    fwrite(rgb, 1, 3, out);
+  }
+  return !ferror(out);
+}
+
+
+bool writeFrame(const Options& options, HostDisplay* display, uint32_t frame)
+{
+  if (strcmp(options.output, "-") == 0)
+    return writePPM(stdout, display);
+
+  char name[512];
+  snprintf(name, sizeof(name), options.output, frame);
+
+  FILE* out = fopen(name, "wb");
+  if (out == nullptr)
+  {
+    fprintf(stderr, "can't write %s\n", name);
+    return false;
+  }
+  bool ok = writePPM(out, display);
+  fclose(out);
+  return ok;
+}
+
+
+
+
+int usage()
+{
+  fprintf(stderr, "usage: auroraHost [-d display] [-p pattern|all] [-n frames] [-a source]\n"
+                  "                  [-s dir] [-o name%%d.ppm|-] [-e every] [-q] [-l]\n");
+  return 2;
+}
+
+
+int main(int argc, char** argv)
+{
+  Options options;
+  bool list = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "d:p:n:a:s:o:e:ql")) != -1)
+  {
+    switch (opt)
+    {
+      case 'd': options.display = optarg; break;
+      case 'p': options.pattern = optarg; break;
+      case 'n': options.frames = atoi(optarg); break;
+      case 'a': options.source = optarg; break;
+      case 's': hostSdRoot(optarg); break;
+      case 'o': options.output = optarg; break;
+      case 'e': options.every = max(atoi(optarg), 1); break;
+      case 'q': options.quiet = true; break;
+      case 'l': list = true; break;
+      default: return usage();
+    }
+  }
+
+  HostDisplay* display = HostDisplay::find(options.display);
+  if (display == nullptr)
+  {
+    fprintf(stderr, "no display %s, one of:\n", options.display);
+    listDisplays();
+    return 2;
+  }
+
+  // frames on stdout, so Serial goes to stderr
+  if (options.quiet)
+    hostSerialOutput(nullptr);
+  else if (options.output && strcmp(options.output, "-") == 0)
+    hostSerialOutput(stderr);
+
+  display->setup();
+
+  if (list)
+  {
+    listDisplays();
+    printf("\npatterns on %s:\n", display->name);
+    listPatterns(display);
+    return 0;
+  }
+
+  if (!display->setAudioSource(options.source))
+  {
+    fprintf(stderr, "no audio source %s\n", options.source);
+    return 2;
+  }
+
+  uint8_t first, last;
+  if (strcmp(options.pattern, "all") == 0)
+  {
+    first = 1;
+    last = display->numPatterns() - 1;
+  }
+  else
+  {
+    first = last = atoi(options.pattern);
+    if (first >= display->numPatterns())
+    {
+      fprintf(stderr, "pattern %u out of range, %s has 0..%u\n",
+              first, display->name, display->numPatterns() - 1);
+      return 2;
+    }
+  }
+
+  uint32_t frame = 0;
+  for (uint16_t p = first; p <= last; p++)
+  {
+    display->setPattern(p);
+
+    for (uint32_t f = 0; f < options.frames; f++, frame++)
+    {
+      hostAdvance(display->framePeriod());
+      display->frame();
+
+      if (options.output && frame % options.every == 0)
+      {
+        if (!writeFrame(options, display, frame))
+          return 1;
+      }
+    }
+  }
+
+  return 0;
+}
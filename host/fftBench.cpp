@@ -0,0 +1,269 @@
+/*************************************************************
+
+   fftBench.cpp - times the FFT (fftAudio.h) and the patterns
+   drawn from it over WAV input
+
+     fftBench -w song.wav        a 16-bit PCM WAV file
+     fftBench                    a made up test signal
+     fftBench -t 1000            a 1 kHz tone, checks it lands in
+                                 the right band (ctest)
+
+   -w file       WAV file to play into the ADC
+   -t freq       pure tone instead, exits 1 if the loudest fft
+                 band doesn't cover freq
+   -n frames     frames to run (500)
+
+   The big display is built with USE_FFT_AUDIO. The clock is
+   virtual: each frame moves it on 10 mS, which runs the 20 kHz
+   sample timer over the next 10 mS of the input through
+   analogRead(). calcFftBands() and the analyzer7, analyzer16 and
+   fallingSpectro frames are timed on the wall clock.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#include "hostDisplay.h"
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+
+
+namespace fft {
+#include "../auroraMusic.ino"
+}
+
+
+#define FRAME_US    10000
+
+
+// the input, mono, -1..1
+std::vector<float> samples;
+uint32_t sampleRate = 44100;
+
+
+
+
+bool loadWav(const char* name)
+{
+  FILE* in = fopen(name, "rb");
+  if (in == nullptr)
+    return false;
+
+  char id[4];
+  uint32_t size;
+  uint16_t format = 0, channels = 0, bits = 0;
+  bool ok = fread(id, 1, 4, in) == 4 && memcmp(id, "RIFF", 4) == 0 &&
+            fread(&size, 4, 1, in) == 1 &&
+            fread(id, 1, 4, in) == 4 && memcmp(id, "WAVE", 4) == 0;
+
+  while (ok && fread(id, 1, 4, in) == 4 && fread(&size, 4, 1, in) == 1)
+  {
+    long next = ftell(in) + size + (size & 1);
+
+    if (memcmp(id, "fmt ", 4) == 0)
+    {
+      ok = fread(&format, 2, 1, in) == 1 && fread(&channels, 2, 1, in) == 1 &&
+           fread(&sampleRate, 4, 1, in) == 1 &&
+           fseek(in, 6, SEEK_CUR) == 0 && fread(&bits, 2, 1, in) == 1;
+    }
+    else if (memcmp(id, "data", 4) == 0)
+    {
+      if (format != 1 || bits != 16 || channels < 1)
+        break;
+
+      std::vector<int16_t> raw(size / 2);
+      raw.resize(fread(raw.data(), 2, raw.size(), in));
+      for (size_t i = 0; i + channels <= raw.size(); i += channels)
+      {
+        float sum = 0;
+        for (uint16_t c = 0; c < channels; c++)
+          sum += raw[i + c];
+        samples.push_back(sum / channels / 32768.0f);
+      }
+      break;
+    }
+    fseek(in, next, SEEK_SET);
+  }
+
+  fclose(in);
+  return !samples.empty();
+}
+
+
+
+
+// a kick every half second under a slow log sweep 50 Hz - 8 kHz
+void makeTestSignal(float seconds)
+{
+  uint32_t count = seconds * sampleRate;
+  float phase = 0;
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    float t = (float)i / sampleRate;
+    float freq = 50 * powf(160, fmodf(t, 4) / 4);
+    phase += TWO_PI * freq / sampleRate;
+
+    float beat = fmodf(t, 0.5);
+    float kick = expf(-beat * 30) * sinf(TWO_PI * 55 * beat);
+    samples.push_back(0.4f * sinf(phase) + 0.5f * kick);
+  }
+}
+
+
+void makeTone(float freq, float seconds)
+{
+  uint32_t count = seconds * sampleRate;
+  for (uint32_t i = 0; i < count; i++)
+    samples.push_back(0.8f * sinf(TWO_PI * freq * i / sampleRate));
+}
+
+
+
+
+// the ADC sees the input at the virtual time, biased to mid
+// scale like the line input
+int wavInput(uint8_t)
+{
+  uint64_t index = (uint64_t)micros() * sampleRate / 1000000;
+  float x = samples[index % samples.size()];
+  return constrain(512 + (int)(x * 511), 0, 1023);
+}
+
+
+
+
+struct Times {
+  std::vector<uint32_t> us;
+
+  void print(const char* name)
+  {
+    std::sort(us.begin(), us.end());
+    uint64_t sum = 0;
+    for (uint32_t t : us)
+      sum += t;
+
+    printf("%-16s %7lu %7lu %7lu %7lu\n", name, (unsigned long)(sum / us.size()),
+           (unsigned long)us[us.size() / 2], (unsigned long)us[us.size() * 99 / 100],
+           (unsigned long)us.back());
+  }
+};
+
+
+template <class F>
+uint32_t timeIt(F f)
+{
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / 1000;
+}
+
+
+
+
+// which band is loudest over the run, and does it cover freq
+bool checkTone(float freq, const uint32_t* bandSums)
+{
+  uint16_t loudest = 0;
+  for (uint16_t band = 1; band < FFT_BANDS; band++)
+    if (bandSums[band] > bandSums[loudest])
+      loudest = band;
+
+  float binWidth = (float)FFT_SAMPLE_RATE / FFT_SIZE;
+  float low = fft::fftBandStart[loudest] * binWidth;
+  float high = fft::fftBandStart[loudest + 1] * binWidth;
+
+  printf("loudest band %u, %.0f - %.0f Hz\n", loudest, low, high);
+  return freq >= low - binWidth && freq < high + binWidth;
+}
+
+
+
+
+int main(int argc, char** argv)
+{
+  const char* wavName = nullptr;
+  float tone = 0;
+  uint32_t frames = 500;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "w:t:n:")) != -1)
+  {
+    switch (opt)
+    {
+      case 'w': wavName = optarg; break;
+      case 't': tone = atof(optarg); break;
+      case 'n': frames = max(atoi(optarg), 1); break;
+      default:
+        fprintf(stderr, "usage: fftBench [-w file.wav | -t freq] [-n frames]\n");
+        return 2;
+    }
+  }
+
+  if (wavName)
+  {
+    if (!loadWav(wavName))
+    {
+      fprintf(stderr, "can't read %s, only 16-bit PCM\n", wavName);
+      return 2;
+    }
+  }
+  else if (tone > 0)
+    makeTone(tone, 2);
+  else
+    makeTestSignal(8);
+
+  hostAnalogInput(wavInput);
+  hostSerialOutput(nullptr);
+  fft::setup();
+
+  if (!fft::fftActive())
+  {
+    fprintf(stderr, "the fft isn't the audio source\n");
+    return 1;
+  }
+
+  printf("fft: %u points, %u bands, %u Hz, input %s, %u frames\n",
+         FFT_SIZE, FFT_BANDS, FFT_SAMPLE_RATE,
+         wavName ? wavName : tone > 0 ? "tone" : "test signal", frames);
+
+  // the fft on its own, and the sums for the tone check
+  Times fftTimes;
+  uint32_t bandSums[FFT_BANDS] = {0};
+
+  for (uint32_t f = 0; f < frames; f++)
+  {
+    hostAdvance(FRAME_US);
+    fftTimes.us.push_back(timeIt(fft::calcFftBands));
+
+    for (uint16_t band = 0; band < FFT_BANDS; band++)
+      bandSums[band] += fft::fftBands[band];
+  }
+
+  printf("\n                    mean     p50     p99   worst  (uS)\n");
+  fftTimes.print("calcFftBands");
+
+  // the patterns drawn from it, whole frames
+  const uint8_t patterns[] = {fft::ANALYZER7, fft::ANALYZER16, fft::FALLINGSPECTRO};
+  for (uint8_t p : patterns)
+  {
+    Times frameTimes;
+    fft::pattern = p;
+
+    for (uint32_t f = 0; f < frames; f++)
+    {
+      hostAdvance(FRAME_US);
+      frameTimes.us.push_back(timeIt([] { fft::audioPatterns.update(); }));
+    }
+    frameTimes.print(fft::patternName[p].c_str());
+  }
+
+  if (tone > 0)
+    return checkTone(tone, bandSums) ? 0 : 1;
+  return 0;
+}
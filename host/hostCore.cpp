@@ -0,0 +1,412 @@
+/*************************************************************
+
+   hostCore.cpp - the stand-in core: clock, timers, Serial,
+   random numbers, noise and the EEPROM / SD globals
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#include "Arduino.h"
+#include "FastLED.h"
+#include "EEPROM.h"
+#include "SD.h"
+
+#include <chrono>
+
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+SDClass SD;
+uint16_t rand16seed = 1337;
+
+
+#define HOST_TIMERS   4
+
+
+struct HostTimer {
+  void (*callback)();
+  uint32_t period;
+  uint64_t next;
+};
+
+
+static bool realClock = false;
+static uint64_t virtualMicros = 0;
+static uint64_t skippedMicros = 0;
+static const auto clockStart = std::chrono::steady_clock::now();
+
+static HostTimer timers[HOST_TIMERS];
+
+static int (*analogInput)(uint8_t pin) = nullptr;
+
+static FILE* serialOut = stdout;
+static std::string serialIn;
+
+static uint32_t randomState = 1;
+
+
+
+
+// ---- clock --------------------------------------
+
+static uint64_t nowMicros()
+{
+  if (!realClock)
+    return virtualMicros;
+
+  auto elapsed = std::chrono::steady_clock::now() - clockStart;
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + skippedMicros;
+}
+
+
+uint32_t micros()
+{
+  return nowMicros();
+}
+
+
+uint32_t millis()
+{
+  return nowMicros() / 1000;
+}
+
+
+void hostRealClock(bool on)
+{
+  if (on == realClock)
+    return;
+
+  // carry on from the same time either way
+  uint64_t now = nowMicros();
+  realClock = on;
+  if (on)
+  {
+    skippedMicros = 0;
+    skippedMicros = now - nowMicros();
+  }
+  else
+    virtualMicros = now;
+}
+
+
+// run the timers that fall due on the way, in order
+void hostAdvance(uint32_t us)
+{
+  if (realClock)
+  {
+    skippedMicros += us;
+    return;
+  }
+
+  uint64_t target = virtualMicros + us;
+
+  while (true)
+  {
+    HostTimer* due = nullptr;
+    for (uint8_t i = 0; i < HOST_TIMERS; i++)
+    {
+      if (timers[i].callback && timers[i].next <= target &&
+          (due == nullptr || timers[i].next < due->next))
+        due = &timers[i];
+    }
+
+    if (due == nullptr)
+      break;
+
+    virtualMicros = due->next;
+    due->next += due->period;
+    due->callback();
+  }
+
+  virtualMicros = target;
+}
+
+
+void delay(uint32_t ms)
+{
+  hostAdvance(ms * 1000);
+}
+
+
+void delayMicroseconds(uint32_t us)
+{
+  hostAdvance(us);
+}
+
+
+
+
+// ---- timers -------------------------------------
+
+bool IntervalTimer::begin(void (*callback)(), uint32_t microseconds)
+{
+  end();
+  if (microseconds == 0)
+    return false;
+
+  for (uint8_t i = 0; i < HOST_TIMERS; i++)
+  {
+    if (timers[i].callback == nullptr)
+    {
+      timers[i].callback = callback;
+      timers[i].period = microseconds;
+      timers[i].next = nowMicros() + microseconds;
+      _slot = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+void IntervalTimer::end()
+{
+  if (_slot >= 0)
+    timers[_slot].callback = nullptr;
+  _slot = -1;
+}
+
+
+
+
+// ---- analog input -------------------------------
+
+int analogRead(uint8_t pin)
+{
+  return analogInput ? analogInput(pin) : 0;
+}
+
+
+void hostAnalogInput(int (*read)(uint8_t pin))
+{
+  analogInput = read;
+}
+
+
+
+
+// ---- random -------------------------------------
+
+long random(long howBig)
+{
+  if (howBig <= 0)
+    return 0;
+
+  randomState = randomState * 1664525 + 1013904223;
+  return (randomState >> 8) % howBig;
+}
+
+
+long random(long howSmall, long howBig)
+{
+  if (howSmall >= howBig)
+    return howSmall;
+  return random(howBig - howSmall) + howSmall;
+}
+
+
+// 0 is ignored, as on the Arduino
+void randomSeed(uint32_t seed)
+{
+  if (seed != 0)
+    randomState = seed;
+}
+
+
+
+
+// ---- Serial -------------------------------------
+
+size_t Print::printNumber(long long n, int base)
+{
+  if (base == DEC)
+  {
+    char text[24];
+    snprintf(text, sizeof(text), "%lld", n);
+    return print(text);
+  }
+  return printNumber((unsigned long long)n, base);
+}
+
+
+size_t Print::printNumber(unsigned long long n, int base)
+{
+  if (base < 2 || base > 16)
+    base = DEC;
+
+  char text[66];
+  char* p = &text[sizeof(text) - 1];
+  *p = 0;
+
+  do
+  {
+    *--p = "0123456789ABCDEF"[n % base];
+    n /= base;
+  } while (n > 0);
+
+  return print(p);
+}
+
+
+size_t Print::print(double n, int digits)
+{
+  char text[48];
+  snprintf(text, sizeof(text), "%.*f", digits, n);
+  return print(text);
+}
+
+
+size_t HardwareSerial::write(const char* s, size_t count)
+{
+  if (serialOut == nullptr)
+    return count;
+
+  // the sketch ends lines with \r\n for the serial monitor
+  size_t written = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (s[i] != '\r')
+      fputc(s[i], serialOut);
+    written++;
+  }
+  return written;
+}
+
+
+int HardwareSerial::available()
+{
+  return serialIn.size();
+}
+
+
+int HardwareSerial::read()
+{
+  if (serialIn.empty())
+    return -1;
+
+  int c = (uint8_t)serialIn[0];
+  serialIn.erase(0, 1);
+  return c;
+}
+
+
+int HardwareSerial::peek()
+{
+  return serialIn.empty() ? -1 : (uint8_t)serialIn[0];
+}
+
+
+void HardwareSerial::flush()
+{
+  if (serialOut)
+    fflush(serialOut);
+}
+
+
+void hostSerialOutput(FILE* out)
+{
+  serialOut = out;
+}
+
+
+void hostSerialType(const char* text)
+{
+  serialIn += text;
+}
+
+
+
+
+// ---- noise --------------------------------------
+
+// improved Perlin noise, with its own fixed permutation
+static uint8_t perm[512];
+
+
+static bool makePermutation()
+{
+  uint32_t state = 0x5EED;
+
+  for (uint16_t i = 0; i < 256; i++)
+    perm[i] = i;
+
+  for (uint16_t i = 255; i > 0; i--)
+  {
+    state = state * 1664525 + 1013904223;
+    uint16_t j = (state >> 8) % (i + 1);
+    uint8_t t = perm[i];
+    perm[i] = perm[j];
+    perm[j] = t;
+  }
+
+  for (uint16_t i = 0; i < 256; i++)
+    perm[256 + i] = perm[i];
+  return true;
+}
+
+static bool permReady = makePermutation();
+
+
+static float fade(float t)
+{
+  return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+
+static float lerp(float t, float a, float b)
+{
+  return a + t * (b - a);
+}
+
+
+static float grad(uint8_t hash, float x, float y, float z)
+{
+  uint8_t h = hash & 15;
+  float u = h < 8 ? x : y;
+  float v = h < 4 ? y : (h == 12 || h == 14) ? x : z;
+  return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+
+// about -1..1
+static float noise3(float x, float y, float z)
+{
+  int xi = (int)floorf(x) & 255;
+  int yi = (int)floorf(y) & 255;
+  int zi = (int)floorf(z) & 255;
+  x -= floorf(x);
+  y -= floorf(y);
+  z -= floorf(z);
+
+  float u = fade(x);
+  float v = fade(y);
+  float w = fade(z);
+
+  int a = perm[xi] + yi, aa = perm[a] + zi, ab = perm[a + 1] + zi;
+  int b = perm[xi + 1] + yi, ba = perm[b] + zi, bb = perm[b + 1] + zi;
+
+  return lerp(w, lerp(v, lerp(u, grad(perm[aa], x, y, z),
+                                 grad(perm[ba], x - 1, y, z)),
+                         lerp(u, grad(perm[ab], x, y - 1, z),
+                                 grad(perm[bb], x - 1, y - 1, z))),
+                 lerp(v, lerp(u, grad(perm[aa + 1], x, y, z - 1),
+                                 grad(perm[ba + 1], x - 1, y, z - 1)),
+                         lerp(u, grad(perm[ab + 1], x, y - 1, z - 1),
+                                 grad(perm[bb + 1], x - 1, y - 1, z - 1))));
+}
+
+
+uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z)
+{
+  float n = noise3(x / 65536.0f, y / 65536.0f, z / 65536.0f);
+  return constrain(32768 + n * 32767, 0.0f, 65535.0f);
+}
+
+
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z)
+{
+  float n = noise3(x / 256.0f, y / 256.0f, z / 256.0f);
+  return constrain(128 + n * 127, 0.0f, 255.0f);
+}
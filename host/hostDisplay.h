@@ -0,0 +1,91 @@
+/*************************************************************
+
+   hostDisplay.h - one built copy of the sketch per hardware.h
+   display
+
+   sketch.cpp is compiled once for each display (CMakeLists.txt)
+   with the whole sketch inside a namespace, so every display can
+   be linked into the same program. Each copy registers a
+   HostDisplay under a short name ("big", "lil", "cabinet",
+   "xlights") that the host programs drive the sketch through.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include "Arduino.h"
+#include "FastLED.h"
+#include "SmartMatrix4.h"
+#include "EEPROM.h"
+#include "PrintValues.h"
+#include "SD.h"
+#include "ADC.h"
+
+
+// frame times of one pattern, uS (BenchResult in benchmark.h)
+struct HostBenchResult {
+  uint32_t mean;
+  uint32_t p50;
+  uint32_t p99;
+  uint32_t worst;
+};
+
+
+
+class HostDisplay {
+  public:
+    HostDisplay(const char* name) : name(name)
+    {
+      // kept in the order they're linked
+      HostDisplay** last = &first;
+      while (*last)
+        last = &(*last)->next;
+      *last = this;
+    }
+
+    // setup(), then the frames one at a time
+    virtual void setup() = 0;
+    virtual void frame() = 0;
+
+    // target frame time of the current pattern, uS
+    virtual uint32_t framePeriod() = 0;
+
+    virtual const char* displayName() = 0;
+    virtual uint16_t width() = 0;
+    virtual uint16_t height() = 0;
+
+    virtual uint8_t numPatterns() = 0;
+    virtual const char* patternName(uint8_t p) = 0;
+    virtual void setPattern(uint8_t p) = 0;
+
+    // by name (msgeq7, sim, replay, wav, fft), false if there
+    // isn't one
+    virtual bool setAudioSource(const char* source) = 0;
+
+    // benchmark.h, false if the pattern didn't run
+    virtual void beginBenchmark() = 0;
+    virtual bool benchPattern(uint8_t p, uint16_t frames, HostBenchResult& result) = 0;
+    virtual void endBenchmark() = 0;
+
+    // what the panel shows, and at what brightness
+    virtual const rgb24* pixels() = 0;
+    virtual uint8_t brightness() = 0;
+
+
+    static HostDisplay* find(const char* name)
+    {
+      for (HostDisplay* d = first; d; d = d->next)
+        if (strcmp(d->name, name) == 0)
+          return d;
+      return nullptr;
+    }
+
+
+    const char* name;
+    HostDisplay* next = nullptr;
+    inline static HostDisplay* first = nullptr;
+};
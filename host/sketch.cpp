@@ -0,0 +1,88 @@
+/*************************************************************
+
+   sketch.cpp - the sketch built for one display
+
+   CMakeLists.txt compiles this once per hardware.h display with
+   HOST_BUILD, the display's define (BIG_MUSIC_FRAME ...) and
+   HOST_DISPLAY set to the short name, which is also the
+   namespace the sketch ends up in.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#include "hostDisplay.h"
+
+
+#define HOST_STR2(x)    #x
+#define HOST_STR(x)     HOST_STR2(x)
+
+
+namespace HOST_DISPLAY {
+
+#include "../auroraMusic.ino"
+
+
+class SketchDisplay : public HostDisplay {
+  public:
+    SketchDisplay() : HostDisplay(HOST_STR(HOST_DISPLAY)) {}
+
+    void setup()
+    {
+      HOST_DISPLAY::setup();
+    }
+
+    // loop() without the wait, the host moves the clock on
+    void frame()
+    {
+      beginFrame();
+      audioPatterns.update();
+      ticks += 1;
+      frameMicros = micros() - frameStart;
+    }
+
+    uint32_t framePeriod() { return HOST_DISPLAY::framePeriod(); }
+
+    const char* displayName() { return DISPLAY_NAME; }
+    uint16_t width() { return kMatrixWidth; }
+    uint16_t height() { return kMatrixHeight; }
+
+    uint8_t numPatterns() { return HOST_DISPLAY::numPatterns; }
+    const char* patternName(uint8_t p) { return HOST_DISPLAY::patternName[p].c_str(); }
+    void setPattern(uint8_t p) { pattern = p; }
+
+    bool setAudioSource(const char* source)
+    {
+      for (uint8_t i = 0; i < numAudioSources; i++)
+      {
+        if (strcmp(audioSources[i]->name(), source) == 0)
+        {
+          selectAudioSource(i);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void beginBenchmark() { HOST_DISPLAY::beginBenchmark(); }
+    void endBenchmark() { HOST_DISPLAY::endBenchmark(); }
+
+    bool benchPattern(uint8_t p, uint16_t frames, HostBenchResult& result)
+    {
+      BenchResult bench;
+      if (!HOST_DISPLAY::benchPattern(p, bench, frames))
+        return false;
+
+      result = {bench.mean, bench.p50, bench.p99, bench.worst};
+      return true;
+    }
+
+    const rgb24* pixels() { return backgroundLayer.frontBuffer(); }
+    uint8_t brightness() { return matrix.brightness(); }
+};
+
+
+SketchDisplay sketchDisplay;
+
+}
@@ -0,0 +1,395 @@
+/*************************************************************
+
+   streamTest.cpp - the row by row stream and smear passes
+   (Effects.h) against the column by column ones they replaced
+
+   The old passes are kept here as they were, walking the buffer
+   a column at a time through at(x, y). Each pass is run both ways
+   on the same buffer, a few times over, and the results have to
+   match byte for byte:
+     - random buffers, every tile marked
+     - a few lit pixels, only their tiles marked, so the new
+       passes skip the black tiles. Every lit pixel's tile has to
+       stay marked after each pass
+
+   qadd8Word() is also checked against qadd8() for every pair of
+   bytes in every lane of the word. On the host that's the C
+   version, the UQADD8 one is only built for the Teensy.
+
+   scale8Bytes() is checked against scale8() for every byte at
+   every scale, starting at each offset from a word boundary so
+   the single byte head, the word loop and the tail all see every
+   value in every lane. What it returns has to be the OR of the
+   scaled bytes.
+
+   Exits 1 and says what failed.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#include "hostDisplay.h"
+
+#include <vector>
+
+
+namespace stream {
+#include "../../auroraMusic.ino"
+}
+
+using stream::canvas;
+using stream::effects;
+
+
+#define TEST_SEEDS      8
+#define TEST_PASSES     6
+#define SPARSE_PIXELS   40
+
+// the passes run up to kScreenWidth / kScreenHeight, which are
+// one less than the screen, set by setup()
+uint16_t W, H;
+const uint16_t stride = stream::kMatrixWidth;
+const uint32_t pixelCount = (uint32_t)stream::kMatrixWidth * stream::kMatrixHeight;
+
+
+int failures = 0;
+
+
+
+
+void check(bool ok, const char* what, const char* pass, uint8_t scale)
+{
+  if (!ok && failures++ < 10)
+    printf("FAIL: %s, %s scale %u\n", what, pass, scale);
+}
+
+
+
+
+// the old passes, a column at a time
+rgb24* ref;
+
+rgb24& at(uint16_t x, uint16_t y)
+{
+  return ref[(uint32_t)y * stride + x];
+}
+
+
+void oldStreamDown(uint8_t scale)
+{
+  for (uint16_t x = 0; x < W; x++)
+  {
+    for (uint16_t y = 1; y < H; y++)
+    {
+      at(x, y) += at(x, y - 1);
+      at(x, y).nscale8(scale);
+    }
+  }
+
+  for (uint16_t x = 0; x < W; x++)
+    at(x, H - 1).nscale8(scale);
+}
+
+
+void oldStreamUp(uint8_t scale)
+{
+  for (uint16_t x = 0; x < W; x++)
+  {
+    for (uint16_t y = H - 2; y > 0; y--)
+    {
+      at(x, y) += at(x, y + 1);
+      at(x, y).nscale8(scale);
+    }
+  }
+
+  for (uint16_t x = 0; x < W; x++)
+    at(x, H - 1).nscale8(scale);
+}
+
+
+void oldStreamRight(uint8_t scale, uint16_t fromX, uint16_t toX, uint16_t fromY, uint16_t toY)
+{
+  for (uint16_t x = fromX + 1; x < toX; x++)
+  {
+    for (uint16_t y = fromY; y < toY; y++)
+    {
+      at(x, y) += at(x - 1, y);
+      at(x, y).nscale8(scale);
+    }
+  }
+
+  for (uint16_t y = fromY; y < toY; y++)
+    at(0, y).nscale8(scale);
+}
+
+
+void oldStreamLeft(uint8_t scale, uint16_t fromX, uint16_t toX, uint16_t fromY, uint16_t toY)
+{
+  for (uint16_t x = toX; x < fromX - 1; x++)
+  {
+    for (uint16_t y = fromY; y < toY; y++)
+    {
+      at(x, y) += at(x + 1, y);
+      at(x, y).nscale8(scale);
+    }
+  }
+  for (uint16_t y = fromY; y < toY; y++)
+    at(0, y).nscale8(scale);
+}
+
+
+void oldStreamUpAndLeft(uint8_t scale)
+{
+  for (uint16_t x = 0; x < W - 1; x++)
+  {
+    for (uint16_t y = H - 2; y > 0; y--)
+    {
+      at(x, y) += at(x + 1, y + 1);
+      at(x, y).nscale8(scale);
+    }
+  }
+  for (uint16_t x = 1; x < W; x++)
+    at(x, H - 1).nscale8(scale);
+
+  for (uint16_t y = 0; y < H; y++)
+    at(W - 1, y).nscale8(scale);
+}
+
+
+void oldStreamUpAndRight(uint8_t scale)
+{
+  for (uint16_t x = 0; x < W - 1; x++)
+  {
+    for (uint16_t y = H - 2; y > 0; y--)
+    {
+      at(x + 1, y) += at(x, y + 1);
+      at(x, y).nscale8(scale);
+    }
+  }
+
+  for (uint16_t x = 0; x < W; x++)
+    at(x, H - 1).nscale8(scale);
+
+  for (uint16_t y = 0; y < H; y++)
+    at(W - 1, y).nscale8(scale);
+}
+
+
+void oldSmearHorizontal(uint8_t scale)
+{
+  for (uint16_t x = 1; x < W; x++)
+  {
+    for (uint16_t y = 0; y < H; y++)
+    {
+      at(x, y) += at(x - 1, y);
+      at(x, y) += at(x, y);
+      at(x, y) += at(x + 1, y);
+      at(x, y).nscale8(scale);
+    }
+  }
+}
+
+
+
+
+struct Pass {
+  const char* name;
+  void (*oldPass)(uint8_t scale);
+  void (*newPass)(uint8_t scale);
+};
+
+const Pass passes[] = {
+  { "StreamDown", oldStreamDown, [](uint8_t s) { effects.StreamDown(s); } },
+  { "StreamUp", oldStreamUp, [](uint8_t s) { effects.StreamUp(s); } },
+  { "StreamRight", [](uint8_t s) { oldStreamRight(s, 0, W, 0, H); },
+                   [](uint8_t s) { effects.StreamRight(s); } },
+  { "StreamRight part", [](uint8_t s) { oldStreamRight(s, 7, W - 21, 3, H - 9); },
+                        [](uint8_t s) { effects.StreamRight(s, 7, W - 21, 3, H - 9); } },
+  { "StreamLeft", [](uint8_t s) { oldStreamLeft(s, W, 0, 0, H); },
+                  [](uint8_t s) { effects.StreamLeft(s); } },
+  { "StreamLeft part", [](uint8_t s) { oldStreamLeft(s, W - 5, 18, 11, H - 2); },
+                       [](uint8_t s) { effects.StreamLeft(s, W - 5, 18, 11, H - 2); } },
+  { "StreamUpAndLeft", oldStreamUpAndLeft, [](uint8_t s) { effects.StreamUpAndLeft(s); } },
+  { "StreamUpAndRight", oldStreamUpAndRight, [](uint8_t s) { effects.StreamUpAndRight(s); } },
+  { "smearHorizontal", oldSmearHorizontal, [](uint8_t s) { effects.smearHorizontal(s); } },
+};
+
+const uint8_t scales[] = { 0, 1, 64, 120, 128, 250, 255 };
+
+
+
+
+// every lit pixel has its tile marked
+bool tilesCover()
+{
+  for (uint16_t y = 0; y < canvas.height(); y++)
+  {
+    uint32_t bits = canvas.tileRowBits(y >> TILE_SHIFT);
+    const rgb24* row = canvas.row(y);
+
+    for (uint16_t x = 0; x < canvas.width(); x++)
+    {
+      if ((row[x].red | row[x].green | row[x].blue) && !((bits >> (x >> TILE_SHIFT)) & 1))
+        return false;
+    }
+  }
+  return true;
+}
+
+
+void fillRandom(bool sparse)
+{
+  if (sparse)
+  {
+    canvas.fillScreen(rgb24(0, 0, 0));
+    for (uint16_t i = 0; i < SPARSE_PIXELS; i++)
+      canvas.drawPixel(random(canvas.width()), random(canvas.height()), rgb24(random(256), random(256), random(256)));
+    return;
+  }
+
+  uint8_t* bytes = (uint8_t*)canvas.buffer();
+  for (uint32_t i = 0; i < pixelCount * sizeof(rgb24); i++)
+    bytes[i] = random(256);
+  canvas.markAll();
+}
+
+
+void testPasses(bool sparse)
+{
+  std::vector<rgb24> old(pixelCount);
+  ref = old.data();
+  uint32_t bytes = pixelCount * sizeof(rgb24);
+
+  for (const Pass& pass : passes)
+  {
+    for (uint8_t scale : scales)
+    {
+      for (uint8_t seed = 0; seed < TEST_SEEDS; seed++)
+      {
+        randomSeed(seed + 1);
+        fillRandom(sparse);
+        memcpy(ref, canvas.buffer(), bytes);
+
+        for (uint8_t n = 0; n < TEST_PASSES; n++)
+        {
+          pass.oldPass(scale);
+          pass.newPass(scale);
+
+          check(memcmp(ref, canvas.buffer(), bytes) == 0, sparse ? "sparse differs" : "differs", pass.name, scale);
+          check(tilesCover(), "lit pixel in a clear tile", pass.name, scale);
+        }
+      }
+    }
+  }
+}
+
+
+
+
+void testQadd8Word()
+{
+  const uint8_t others[] = { 0x00, 0x7F, 0x80, 0xFF, 0x5A };
+
+  for (uint8_t lane = 0; lane < 4; lane++)
+  {
+    for (uint32_t a = 0; a < 256; a++)
+    {
+      for (uint32_t b = 0; b < 256; b++)
+      {
+        // the other lanes get a mix, so a carry between lanes shows
+        uint8_t wa[4], wb[4];
+        for (uint8_t i = 0; i < 4; i++)
+        {
+          wa[i] = others[(a + i) % 5];
+          wb[i] = others[(b + 2 * i) % 5];
+        }
+        wa[lane] = a;
+        wb[lane] = b;
+
+        uint32_t x, y;
+        memcpy(&x, wa, 4);
+        memcpy(&y, wb, 4);
+        uint32_t sum = stream::qadd8Word(x, y);
+
+        uint8_t out[4];
+        memcpy(out, &sum, 4);
+        for (uint8_t i = 0; i < 4; i++)
+        {
+          if (out[i] != qadd8(wa[i], wb[i]) && failures++ < 10)
+            printf("FAIL: qadd8Word lane %u: %u + %u = %u\n", i, wa[i], wb[i], out[i]);
+        }
+      }
+    }
+  }
+}
+
+
+
+
+void testScale8Bytes()
+{
+  // all 256 values, plus a few so the run doesn't end on a word
+  const uint32_t count = 256 + 7;
+  alignas(4) uint8_t buffer[count + 4];
+  uint8_t want[count];
+
+  for (uint32_t scale = 0; scale < 256; scale++)
+  {
+    for (uint8_t offset = 0; offset < 4; offset++)
+    {
+      // each offset moves every value to another lane
+      for (uint8_t shift = 0; shift < 4; shift++)
+      {
+        uint8_t* bytes = buffer + offset;
+        uint8_t lit = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+          bytes[i] = (i + shift) & 0xFF;
+          want[i] = scale8(bytes[i], scale);
+          lit |= want[i];
+        }
+
+        uint8_t got = stream::scale8Bytes(bytes, count, scale);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+          if (bytes[i] != want[i] && failures++ < 10)
+            printf("FAIL: scale8Bytes offset %u: scale8(%u, %u) = %u, not %u\n",
+                   offset, (unsigned)((i + shift) & 0xFF), (unsigned)scale, bytes[i], want[i]);
+        }
+        if (got != lit && failures++ < 10)
+          printf("FAIL: scale8Bytes scale %u returned %u, not %u\n", (unsigned)scale, got, lit);
+      }
+    }
+  }
+}
+
+
+
+
+int main()
+{
+  hostSerialOutput(nullptr);
+  stream::setup();
+  W = stream::kScreenWidth;
+  H = stream::kScreenHeight;
+
+  // full size, no ring, tiles tracked
+  canvas.setRenderScale(0);
+  canvas.setScrolling(false);
+  canvas.trackTiles(true);
+  effects.updateBuffer();
+
+  testQadd8Word();
+  testScale8Bytes();
+  testPasses(false);
+  testPasses(true);
+
+  if (failures > 0)
+    return 1;
+
+  printf("%u passes x %u scales x %u buffers, qadd8Word, scale8Bytes: all match\n",
+         (unsigned)(sizeof(passes) / sizeof(passes[0])), (unsigned)sizeof(scales), TEST_SEEDS * 2);
+  return 0;
+}
@@ -0,0 +1,128 @@
+/*************************************************************
+
+   tempoTest.cpp - the onset detector and tempo tracker
+   (beatDetect.h) on a trace with a known tempo
+
+   Plays tempoTrace.h (120 BPM) through the big display at its
+   60 fps with fixedFrameDt, and checks that
+     - onsets are found, and none closer than the hold-off
+     - the tracker locks to 120 BPM (one bin either way)
+     - beats then come every 500 mS of frame time
+     - two runs give the same onsets and beats, with the wall
+       clock running so millis() would differ between them
+
+   Exits 1 and says what failed, otherwise prints a summary.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#include "hostDisplay.h"
+
+#include <vector>
+
+
+namespace tempo {
+#include "../../auroraMusic.ino"
+#include "tempoTrace.h"
+
+ReplaySource tempoSource(tempoTrace, TEMPO_TRACE_FRAMES);
+}
+
+
+#define TRACE_FPS       60
+#define TEST_SECONDS    16
+#define TEST_BPM        120
+
+
+struct Run {
+  std::vector<uint32_t> onsets;     // frameMillis of each
+  std::vector<uint32_t> beats;
+  uint16_t bpm = 0;
+};
+
+
+int failures = 0;
+
+
+
+
+void check(bool ok, const char* what)
+{
+  if (!ok)
+  {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+
+
+
+Run play()
+{
+  using namespace tempo;
+
+  Run run;
+  fixedFrameDt = 1000000 / TRACE_FPS;
+  audioSource = &tempoSource;
+  tempoSource.rewind();
+  resetAudio();
+  resetBeat();
+  frameMillis = 0;
+  frameMillisCarry = 0;
+
+  for (uint32_t f = 0; f < TEST_SECONDS * TRACE_FPS; f++)
+  {
+    beginFrame();
+    audioPatterns.update();
+    delay(1);
+
+    if (onset)
+      run.onsets.push_back(frameMillis);
+    if (beat)
+      run.beats.push_back(frameMillis);
+  }
+
+  run.bpm = bpm;
+  return run;
+}
+
+
+
+
+int main()
+{
+  hostSerialOutput(nullptr);
+  tempo::setup();
+  tempo::pattern = tempo::STARS1;
+  tempo::autoincrement = false;
+
+  // wall clock, so only the frame clock makes the runs match
+  hostRealClock(true);
+  Run first = play();
+  Run second = play();
+
+  check(first.onsets.size() >= TEST_SECONDS * 2, "too few onsets");
+  for (size_t i = 1; i < first.onsets.size(); i++)
+    check(first.onsets[i] - first.onsets[i - 1] > BEAT_HOLDOFF_MS, "onsets inside the hold-off");
+
+  check(abs(first.bpm - TEST_BPM) <= BEAT_BPM_BIN, "not locked to the trace tempo");
+
+  // once locked, the beat clock ticks every beat period
+  uint32_t period = 60000 / TEST_BPM;
+  uint32_t frameMs = 1000 / TRACE_FPS + 1;
+  size_t settled = first.beats.size() / 2;
+  check(first.beats.size() >= TEST_SECONDS, "too few beats");
+  for (size_t i = settled + 1; i < first.beats.size(); i++)
+  {
+    uint32_t gap = first.beats[i] - first.beats[i - 1];
+    check(gap + 2 * frameMs >= period && gap <= period + 2 * frameMs, "beat gap off the tempo");
+  }
+
+  check(first.onsets == second.onsets && first.beats == second.beats, "runs differ");
+
+  printf("onsets %zu, beats %zu, bpm %u\n", first.onsets.size(), first.beats.size(), first.bpm);
+  return failures > 0 ? 1 : 0;
+}
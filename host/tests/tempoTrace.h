@@ -0,0 +1,264 @@
+/*************************************************************
+
+   tempoTrace.h - a band trace with a steady tempo, for the
+   onset / tempo test (tempoTest.cpp)
+
+   240 frames (4 seconds at 60 fps) of raw 10-bit MSGEQ7 values,
+   7 bands per frame. Synthetic: a 120 BPM kick / snare loop with
+   the hi-hats on 8th notes, over a slow melody sweep and the
+   usual ~60 count background offset. It's audioTrace.h with the
+   hi-hats moved onto the 8th notes.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#define TEMPO_TRACE_FRAMES  240
+
+
+const uint16_t tempoTrace[TEMPO_TRACE_FRAMES][EQ_BANDS7] PROGMEM = {
+  { 795,  650,  174,  157,  315,  426,  307},
+  { 725,  578,  179,  150,  229,  310,  250},
+  { 630,  508,  184,  136,  141,  207,  140},
+  { 535,  446,  206,  142,   46,  104,   73},
+  { 446,  415,  202,  144,   65,   98,   85},
+  { 358,  344,  220,  131,   46,   88,   56},
+  { 289,  295,  212,  123,   58,   86,   72},
+  { 189,  227,  223,  126,   71,  104,   60},
+  { 104,  168,  238,  124,   51,   96,   58},
+  { 120,  176,  228,  117,   46,  105,   61},
+  { 120,  178,  249,  108,   69,   97,   69},
+  { 124,  189,  252,  101,   54,   95,   80},
+  { 113,  186,  267,   93,   47,  107,   64},
+  { 126,  182,  276,   92,   68,  104,   64},
+  { 130,  172,  256,   94,   58,   96,   79},
+  { 123,  177,  537,  439,  508,  443,  335},
+  { 135,  177,  495,  379,  396,  351,  249},
+  { 142,  188,  443,  322,  272,  230,  153},
+  { 135,  205,  410,  241,  171,   97,   85},
+  { 126,  197,  380,  198,  113,   96,   78},
+  { 141,  193,  339,  134,   99,  122,   69},
+  { 129,  208,  293,   83,   66,  108,   55},
+  { 151,  202,  295,   58,   64,  100,   70},
+  { 123,  196,  310,   60,   49,  121,   62},
+  { 135,  203,  317,   76,   60,  100,   60},
+  { 137,  204,  307,   56,   73,  103,   81},
+  { 137,  220,  309,   55,   67,  112,   66},
+  { 145,  222,  305,   76,   52,  103,   57},
+  { 129,  198,  301,   66,   52,   99,   70},
+  { 150,  212,  299,   53,   54,   99,   59},
+  { 838,  712,  306,   64,  313,  460,  335},
+  { 741,  654,  321,   61,  241,  352,  241},
+  { 670,  592,  295,   59,  156,  243,  162},
+  { 592,  533,  314,   71,   62,  111,   67},
+  { 486,  455,  295,   62,   65,  111,   56},
+  { 392,  381,  296,   62,   50,  102,   65},
+  { 317,  317,  291,   49,   63,  102,   72},
+  { 212,  282,  297,   70,   45,  100,   82},
+  { 127,  207,  296,   57,   65,  105,   85},
+  { 131,  205,  292,   70,   48,  100,   82},
+  { 134,  198,  293,   73,   54,   98,   59},
+  { 121,  205,  284,   84,   53,  110,   81},
+  { 139,  185,  287,   64,   51,  125,   85},
+  { 132,  189,  271,   89,   62,  123,   55},
+  { 138,  191,  271,   90,   72,   95,   77},
+  { 140,  181,  524,  435,  524,  447,  316},
+  { 135,  177,  478,  386,  402,  341,  231},
+  { 130,  174,  434,  340,  286,  231,  165},
+  { 114,  189,  375,  287,  157,  112,   80},
+  { 113,  166,  337,  222,  122,  111,   55},
+  { 105,  182,  282,  168,   86,   93,   77},
+  { 122,  184,  237,  113,   70,  115,   78},
+  { 112,  180,  231,  106,   52,   88,   62},
+  { 114,  152,  224,  115,   60,  102,   83},
+  { 116,  169,  208,  129,   74,  102,   66},
+  { 120,  159,  204,  145,   66,   84,   84},
+  { 105,  160,  217,  148,   51,   95,   83},
+  {  96,  144,  214,  149,   55,   80,   80},
+  { 119,  150,  195,  148,   57,  100,   85},
+  {  89,  146,  181,  144,   49,   76,   59},
+  { 803,  648,  184,  169,  315,  429,  324},
+  { 721,  572,  178,  171,  240,  318,  225},
+  { 622,  504,  160,  155,  128,  214,  161},
+  { 536,  423,  166,  183,   74,   75,   68},
+  { 453,  360,  170,  192,   51,   69,   63},
+  { 343,  297,  153,  177,   69,   86,   65},
+  { 255,  238,  144,  201,   49,   68,   84},
+  { 181,  166,  153,  194,   66,   84,   81},
+  {  96,  105,  132,  211,   74,   92,   71},
+  {  70,  102,  117,  206,   61,   63,   82},
+  {  79,  106,  112,  213,   45,   86,   80},
+  {  67,   84,  105,  214,   64,   84,   58},
+  {  78,   76,  106,  224,   61,   76,   72},
+  {  74,   97,  115,  210,   73,   76,   56},
+  {  65,   75,   94,  212,   69,   61,   71},
+  {  70,   83,  331,  589,  523,  436,  307},
+  {  69,   74,  304,  526,  397,  305,  227},
+  {  75,   69,  253,  472,  278,  197,  153},
+  {  68,   89,  200,  422,  161,   82,   83},
+  {  81,   86,  156,  374,  128,   82,   85},
+  {  56,   81,  117,  293,   91,   56,   67},
+  {  63,   63,   60,  255,   52,   65,   57},
+  {  54,   72,   64,  261,   48,   80,   79},
+  {  51,   79,   75,  258,   66,   62,   59},
+  {  54,   76,   55,  270,   59,   58,   78},
+  {  76,   50,   61,  269,   60,   55,   76},
+  {  71,   53,   52,  264,   58,   66,   67},
+  {  55,   58,   52,  254,   55,   52,   78},
+  {  56,   45,   55,  261,   59,   64,   77},
+  {  45,   57,   55,  260,   64,   59,   71},
+  { 775,  547,   48,  274,  320,  407,  333},
+  { 660,  484,   53,  252,  212,  311,  245},
+  { 575,  428,   69,  248,  154,  179,  165},
+  { 511,  379,   72,  273,   53,   62,   59},
+  { 412,  325,   63,  260,   60,   72,   65},
+  { 310,  243,   50,  266,   67,   55,   68},
+  { 249,  175,   59,  270,   45,   71,   57},
+  { 160,  120,   55,  257,   72,   58,   57},
+  {  56,   78,   58,  250,   45,   62,   72},
+  {  62,   82,   87,  242,   64,   56,   56},
+  {  66,   77,   68,  261,   48,   58,   63},
+  {  52,   62,   71,  257,   54,   74,   64},
+  {  68,   83,   74,  234,   59,   70,   76},
+  {  58,   69,   83,  247,   45,   63,   56},
+  {  55,   64,  100,  235,   62,   62,   71},
+  {  71,   73,  360,  579,  498,  428,  331},
+  {  78,   82,  315,  518,  395,  317,  249},
+  {  71,   88,  267,  463,  267,  182,  148},
+  {  67,  101,  249,  400,  168,   80,   59},
+  {  75,   90,  186,  342,  115,   61,   57},
+  {  85,  105,  177,  261,   91,   67,   56},
+  {  68,  106,  139,  202,   72,   79,   76},
+  {  77,  108,  126,  207,   54,   65,   69},
+  {  75,   98,  133,  194,   45,   74,   66},
+  { 102,  106,  148,  185,   52,   68,   85},
+  { 102,  109,  143,  181,   50,   68,   65},
+  {  88,  106,  159,  173,   61,   89,   61},
+  {  85,  124,  174,  160,   47,   79,   81},
+  {  82,  116,  168,  173,   46,   84,   55},
+  {  91,  125,  183,  157,   47,   91,   85},
+  { 801,  646,  193,  149,  316,  453,  327},
+  { 724,  589,  195,  151,  235,  319,  244},
+  { 629,  506,  192,  157,  147,  214,  142},
+  { 529,  470,  215,  151,   73,   94,   75},
+  { 456,  408,  217,  149,   61,   84,   84},
+  { 373,  350,  218,  137,   71,  107,   80},
+  { 272,  294,  229,  132,   70,  110,   77},
+  { 207,  239,  236,  129,   52,   85,   55},
+  { 102,  154,  240,  115,   75,   88,   67},
+  { 129,  168,  243,  100,   65,   86,   75},
+  { 121,  178,  239,  110,   53,   87,   69},
+  { 131,  162,  261,  119,   61,  116,   72},
+  { 110,  185,  259,   88,   68,  112,   70},
+  { 118,  192,  250,  109,   53,   97,   78},
+  { 135,  176,  260,  101,   65,  105,   70},
+  { 140,  185,  510,  439,  524,  463,  314},
+  { 138,  176,  490,  382,  398,  332,  223},
+  { 135,  182,  443,  308,  281,  234,  160},
+  { 126,  199,  414,  243,  145,  110,   56},
+  { 133,  190,  379,  180,  133,  101,   76},
+  { 134,  193,  341,  132,   87,  110,   69},
+  { 134,  210,  284,   83,   62,  103,   64},
+  { 123,  217,  299,   53,   54,  111,   57},
+  { 148,  206,  316,   65,   53,  110,   61},
+  { 152,  221,  317,   55,   47,  116,   57},
+  { 127,  215,  306,   56,   75,  110,   59},
+  { 143,  219,  312,   63,   53,  127,   58},
+  { 146,  205,  300,   61,   73,  127,   70},
+  { 136,  194,  299,   45,   75,  114,   76},
+  { 138,  206,  303,   68,   49,  112,   66},
+  { 837,  705,  298,   71,  305,  450,  315},
+  { 761,  642,  320,   57,  214,  363,  250},
+  { 655,  591,  294,   73,  151,  225,  146},
+  { 573,  508,  305,   58,   72,  117,   57},
+  { 485,  472,  305,   71,   53,  126,   56},
+  { 394,  382,  291,   74,   66,  108,   75},
+  { 327,  320,  295,   57,   58,  114,   65},
+  { 215,  276,  297,   76,   75,  111,   83},
+  { 121,  213,  308,   73,   57,  126,   83},
+  { 150,  203,  298,   61,   68,   99,   56},
+  { 148,  207,  291,   72,   64,  120,   59},
+  { 138,  209,  283,   76,   46,  124,   84},
+  { 134,  184,  276,   79,   58,  105,   64},
+  { 125,  186,  290,   90,   65,  102,   67},
+  { 134,  182,  271,   85,   62,  114,   67},
+  { 116,  178,  528,  429,  497,  448,  321},
+  { 139,  195,  476,  386,  385,  339,  250},
+  { 120,  191,  429,  328,  265,  224,  144},
+  { 115,  166,  373,  271,  162,   91,   65},
+  { 113,  171,  329,  232,  129,   94,   83},
+  { 105,  180,  301,  166,   90,  100,   78},
+  { 119,  160,  238,  107,   55,  110,   56},
+  { 116,  158,  238,  134,   56,   89,   76},
+  { 115,  162,  234,  134,   72,  110,   61},
+  {  99,  151,  236,  121,   57,   94,   75},
+  { 109,  152,  232,  128,   72,  107,   82},
+  { 123,  135,  199,  125,   58,  102,   79},
+  { 119,  156,  204,  159,   63,   93,   55},
+  {  91,  139,  212,  163,   74,  103,   71},
+  { 114,  137,  190,  146,   70,   79,   62},
+  { 789,  624,  186,  165,  298,  455,  331},
+  { 718,  575,  183,  177,  235,  335,  235},
+  { 607,  504,  180,  156,  128,  214,  142},
+  { 523,  438,  179,  161,   65,   93,   64},
+  { 456,  358,  164,  173,   61,   89,   68},
+  { 359,  312,  140,  173,   47,   77,   71},
+  { 277,  239,  137,  187,   53,   74,   80},
+  { 177,  155,  125,  197,   54,   80,   63},
+  {  98,   99,  139,  211,   73,   71,   70},
+  {  82,   92,  130,  197,   45,   93,   68},
+  {  86,  102,  116,  196,   45,   68,   70},
+  {  91,  100,  121,  212,   47,   69,   62},
+  {  82,   88,  125,  214,   52,   75,   56},
+  {  81,   82,  113,  220,   56,   80,   67},
+  {  64,   69,  111,  220,   68,   85,   71},
+  {  58,   72,  346,  571,  504,  431,  331},
+  {  61,   71,  299,  517,  386,  313,  249},
+  {  62,   64,  269,  475,  276,  191,  143},
+  {  80,   66,  208,  413,  174,   75,   56},
+  {  81,   76,  152,  374,  123,   55,   61},
+  {  50,   74,  107,  302,   79,   75,   56},
+  {  54,   65,   72,  262,   67,   80,   65},
+  {  71,   54,   57,  265,   50,   62,   61},
+  {  52,   69,   82,  254,   68,   65,   56},
+  {  55,   69,   74,  252,   71,   62,   65},
+  {  60,   52,   52,  241,   47,   58,   57},
+  {  56,   59,   77,  270,   48,   67,   85},
+  {  69,   51,   58,  254,   69,   76,   64},
+  {  71,   70,   58,  246,   46,   72,   70},
+  {  51,   56,   62,  273,   59,   56,   65},
+  { 756,  568,   73,  260,  295,  420,  318},
+  { 664,  507,   65,  268,  223,  284,  233},
+  { 571,  434,   47,  269,  157,  167,  146},
+  { 488,  381,   48,  271,   64,   60,   66},
+  { 403,  306,   77,  272,   64,   51,   63},
+  { 331,  257,   71,  251,   74,   58,   64},
+  { 221,  196,   75,  259,   74,   76,   75},
+  { 165,  142,   55,  238,   71,   58,   58},
+  {  63,   73,   85,  250,   75,   76,   67},
+  {  74,   61,   87,  247,   71,   67,   59},
+  {  79,   70,   66,  231,   70,   82,   78},
+  {  60,   83,   87,  252,   49,   73,   62},
+  {  62,   86,   78,  239,   56,   79,   80},
+  {  72,   63,   88,  228,   57,   79,   60},
+  {  62,   77,   79,  239,   46,   71,   72},
+  {  73,   76,  336,  578,  523,  410,  307},
+  {  66,   88,  296,  509,  381,  304,  236},
+  {  81,   86,  263,  448,  265,  188,  152},
+  {  80,  103,  242,  385,  168,   77,   82},
+  {  87,  100,  209,  319,  135,   87,   64},
+  {  74,   90,  167,  261,   89,   70,   78},
+  {  74,   91,  127,  197,   50,   70,   62},
+  {  72,   98,  147,  214,   63,   70,   65},
+  {  72,  105,  133,  187,   61,   82,   62},
+  {  92,  121,  134,  195,   59,   68,   58},
+  {  74,  115,  165,  196,   52,   94,   69},
+  { 105,  115,  145,  193,   54,   76,   58},
+  {  79,  114,  169,  186,   63,   77,   84},
+  {  82,  123,  172,  182,   50,   86,   74},
+  {  90,  140,  187,  171,   75,   73,   58},
+};
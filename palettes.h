@@ -0,0 +1,282 @@
+/*************************************************************
+
+   palettes.h - 256 color tables for coloring by index
+
+   Every palette is a table of 256 rgb24 colors worked out by the
+   compiler (constexpr) and kept in flash, so coloring a pixel is
+   one table read instead of the branches and multiplies of
+   wheel8() / wheel8Sat():
+
+     row[x] = palette.color(noise[x][y]);
+
+   PALETTE_WHEEL     - wheel8(), blue -> green -> red -> blue
+   PALETTE_WHEEL_SAT - wheel8Sat(), the saturated wheel
+   PALETTE_SPECTRUM  - FastLED hsv2rgb_spectrum, full sat and value
+   PALETTE_RAINBOW .. PALETTE_HEAT - the FastLED CRGBPalette16
+                       presets, blended between the 16 colors the
+                       way ColorFromPalette(LINEARBLEND) does
+
+   palette is the one the index colored patterns use (plasma,
+   life, the radial ones, fallingSpectro). select() changes it
+   straight away, crossfade() blends over to the new one a little
+   every frame in a RAM copy (update() is called from
+   AudioPatterns::update()). setHue() / rotate() shift every index
+   the palette is read with, to turn the colors round.
+
+   The tables are bytes since rgb24 has no constexpr constructor,
+   they're read through a cast, rgb24 is 3 bytes with no padding.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+enum {
+  PALETTE_WHEEL,
+  PALETTE_WHEEL_SAT,
+  PALETTE_SPECTRUM,
+  PALETTE_RAINBOW,
+  PALETTE_PARTY,
+  PALETTE_OCEAN,
+  PALETTE_LAVA,
+  PALETTE_FOREST,
+  PALETTE_CLOUD,
+  PALETTE_HEAT,
+  NUM_PALETTES
+};
+
+
+const char* const paletteName[NUM_PALETTES] = {
+  "wheel", "wheelSat", "spectrum", "rainbow", "party",
+  "ocean", "lava", "forest", "cloud", "heat"
+};
+
+
+static_assert(sizeof(rgb24) == 3, "palettes are read as rgb24");
+
+
+
+// the 16 colors of the FastLED presets, 0xRRGGBB
+constexpr uint32_t paletteKeys[NUM_PALETTES - PALETTE_RAINBOW][16] = {
+  // rainbow
+  { 0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00, 0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+    0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5, 0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B },
+  // party
+  { 0x5500AB, 0x84007C, 0xB5004B, 0xE5001B, 0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+    0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E, 0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9 },
+  // ocean
+  { 0x191970, 0x00008B, 0x191970, 0x000080, 0x00008B, 0x0000CD, 0x2E8B57, 0x008080,
+    0x5F9EA0, 0x0000FF, 0x008B8B, 0x6495ED, 0x7FFFD4, 0x2E8B57, 0x00FFFF, 0x87CEFA },
+  // lava
+  { 0x000000, 0x800000, 0x000000, 0x800000, 0x8B0000, 0x8B0000, 0x800000, 0x8B0000,
+    0x8B0000, 0x8B0000, 0xFF0000, 0xFFA500, 0xFFFFFF, 0xFFA500, 0xFF0000, 0x8B0000 },
+  // forest
+  { 0x006400, 0x006400, 0x556B2F, 0x006400, 0x008000, 0x228B22, 0x6B8E23, 0x008000,
+    0x2E8B57, 0x66CDAA, 0x32CD32, 0x9ACD32, 0x90EE90, 0x7CFC00, 0x66CDAA, 0x228B22 },
+  // cloud
+  { 0x0000FF, 0x00008B, 0x00008B, 0x00008B, 0x00008B, 0x00008B, 0x00008B, 0x00008B,
+    0x0000FF, 0x00008B, 0x87CEEB, 0x87CEEB, 0xADD8E6, 0xFFFFFF, 0xADD8E6, 0x87CEEB },
+  // heat
+  { 0x000000, 0x330000, 0x660000, 0x990000, 0xCC0000, 0xFF0000, 0xFF3300, 0xFF6600,
+    0xFF9900, 0xFFCC00, 0xFFFF00, 0xFFFF33, 0xFFFF66, 0xFFFF99, 0xFFFFCC, 0xFFFFFF }
+};
+
+
+
+struct PaletteBytes {
+  uint8_t rgb[256 * 3];
+};
+
+
+
+// wheel8(), same segments and steps
+constexpr uint8_t wheelChannel(uint8_t i, uint8_t c)
+{
+  return (i < 85)  ? (c == 0 ? 0 : c == 1 ? i * 3 : 255 - i * 3) :
+         (i < 170) ? (c == 0 ? (i - 85) * 3 : c == 1 ? 255 - (i - 85) * 3 : 0) :
+                     (c == 0 ? 255 - (i - 170) * 3 : c == 1 ? 0 : (i - 170) * 3);
+}
+
+
+// wheel8Sat(), blue, cyan, green, yellow, red, violet
+constexpr uint8_t wheelSatChannel(uint8_t i, uint8_t c)
+{
+  return (i < 43)  ? (c == 0 ? 0 : c == 1 ? i * 6 : 255) :
+         (i < 86)  ? (c == 0 ? 0 : c == 1 ? 255 : 255 - (i - 43) * 6) :
+         (i < 128) ? (c == 0 ? (i - 86) * 6 : c == 1 ? 255 : 0) :
+         (i < 171) ? (c == 0 ? 255 : c == 1 ? 255 - (i - 128) * 6 : 0) :
+         (i < 213) ? (c == 0 ? 255 : c == 1 ? 0 : (i - 171) * 6) :
+                     (c == 0 ? 255 - (i - 213) * 6 : c == 1 ? 0 : 255);
+}
+
+
+// hsv2rgb_spectrum(): hue scaled into 3 sections of 64 that
+// ramp up one channel and down the one before it
+constexpr uint8_t spectrumChannel(uint8_t i, uint8_t c)
+{
+  uint8_t hue = (i * 192) >> 8;
+  uint8_t section = hue >> 6;
+  uint8_t up = ((hue & 0x3F) * 255) / 64;
+  uint8_t down = ((0x3F - (hue & 0x3F)) * 255) / 64;
+
+  // which channel is coming up, c + 2 is going down
+  uint8_t rising = (section + 1) % 3;
+  return (c == rising) ? up : (c == section) ? down : 0;
+}
+
+
+// ColorFromPalette(LINEARBLEND) between the 16 colors, scale8()
+// as FastLED has it with FASTLED_SCALE8_FIXED
+constexpr uint8_t keysChannel(const uint32_t* keys, uint8_t i, uint8_t c)
+{
+  uint8_t shift = 16 - c * 8;
+  uint8_t c1 = keys[i >> 4] >> shift;
+  uint8_t c2 = keys[((i >> 4) + 1) & 15] >> shift;
+  uint8_t f2 = (i & 15) << 4;
+  uint8_t f1 = 255 - f2;
+
+  return ((c1 * (1 + f1)) >> 8) + ((c2 * (1 + f2)) >> 8);
+}
+
+
+constexpr PaletteBytes makePalette(uint8_t id)
+{
+  PaletteBytes p{};
+
+  for (uint16_t i = 0; i < 256; i++)
+  {
+    for (uint8_t c = 0; c < 3; c++)
+    {
+      p.rgb[i * 3 + c] =
+        (id == PALETTE_WHEEL)     ? wheelChannel(i, c) :
+        (id == PALETTE_WHEEL_SAT) ? wheelSatChannel(i, c) :
+        (id == PALETTE_SPECTRUM)  ? spectrumChannel(i, c) :
+                                    keysChannel(paletteKeys[id - PALETTE_RAINBOW], i, c);
+    }
+  }
+  return p;
+}
+
+
+
+// in flash, not copied to RAM on Teensy 4
+constexpr PaletteBytes paletteBytes[NUM_PALETTES] PROGMEM = {
+  makePalette(PALETTE_WHEEL),
+  makePalette(PALETTE_WHEEL_SAT),
+  makePalette(PALETTE_SPECTRUM),
+  makePalette(PALETTE_RAINBOW),
+  makePalette(PALETTE_PARTY),
+  makePalette(PALETTE_OCEAN),
+  makePalette(PALETTE_LAVA),
+  makePalette(PALETTE_FOREST),
+  makePalette(PALETTE_CLOUD),
+  makePalette(PALETTE_HEAT)
+};
+
+
+inline const rgb24* paletteTable(uint8_t id)
+{
+  if (id >= NUM_PALETTES)
+    id = PALETTE_WHEEL;
+  return (const rgb24*)paletteBytes[id].rgb;
+}
+
+
+
+class Palette {
+  public:
+
+    // change now
+    void select(uint8_t id)
+    {
+      _id = validPalette(id);
+      _colors = paletteTable(_id);
+      _fadeLeft = 0;
+    }
+
+
+    // blend over to id in ms milliseconds, from whatever is
+    // showing, even part way through another crossfade
+    void crossfade(uint8_t id, uint16_t ms)
+    {
+      if (ms == 0)
+      {
+        select(id);
+        return;
+      }
+
+      if (_colors != _blend)
+        memcpy(_blend, _colors, sizeof(_blend));
+
+      _id = validPalette(id);
+      _colors = _blend;
+      _fadeLeft = ms * 1000UL;
+    }
+
+
+    // once a frame, moves a crossfade on by frameDt
+    void update()
+    {
+      if (_fadeLeft == 0)
+        return;
+
+      const rgb24* target = paletteTable(_id);
+
+      // the part of what's left this frame covers, out of 256
+      if (frameDt >= _fadeLeft)
+      {
+        select(_id);
+        return;
+      }
+      int16_t amount = ((uint64_t)frameDt << 8) / _fadeLeft;
+      _fadeLeft -= frameDt;
+
+      uint8_t* from = (uint8_t*)_blend;
+      const uint8_t* to = (const uint8_t*)target;
+      for (uint16_t i = 0; i < sizeof(_blend); i++)
+        from[i] += ((to[i] - from[i]) * amount) >> 8;
+    }
+
+
+    uint8_t id() { return _id; }
+    bool fading() { return _fadeLeft > 0; }
+
+
+    // offset added to every index the palette is read with
+    void setHue(uint8_t hue) { _hue = hue; }
+    void rotate(int8_t steps) { _hue += steps; }
+    uint8_t hue() { return _hue; }
+
+
+    const rgb24& color(uint8_t index)
+    {
+      return _colors[(uint8_t)(index + _hue)];
+    }
+
+
+    // the table without the hue offset, for inner loops that add
+    // their own
+    const rgb24* colors() { return _colors; }
+
+
+  private:
+    const rgb24* _colors = paletteTable(PALETTE_WHEEL);
+    uint8_t _id = PALETTE_WHEEL;
+    uint8_t _hue = 0;
+    uint32_t _fadeLeft = 0;         // uS left of a crossfade
+    rgb24 _blend[256];
+
+
+    // an id past the end falls back to the wheel
+    static uint8_t validPalette(uint8_t id)
+    {
+      return (id < NUM_PALETTES) ? id : (uint8_t)PALETTE_WHEEL;
+    }
+};
+
+
+
+Palette palette;
@@ -0,0 +1,173 @@
+/*************************************************************
+
+   polar.h - angle and distance from the center for every pixel
+
+   Radial effects can be written per pixel as a function of
+   angle and radius. PolarMap keeps both as bytes for every
+   pixel, worked out once, so a radial shader costs two byte
+   loads instead of atan2 / sqrt:
+
+     const PolarPixel* row = polar.row(y);
+     for (uint16_t x = 0; x < width; x++)
+       ... row[x].angle, row[x].radius ...
+
+   angle  - 0 - 255 for a full turn, 0 = to the right, counting
+            clockwise (screen y is down)
+   radius - 0 at the center (kMatrixCenterX, kMatrixCenterY) to
+            255 at the farthest corner, radiusOf() converts a
+            distance in pixels
+
+   The map is built the first time it's used after a pattern
+   change and freed in AudioPatterns::init() when the new
+   pattern doesn't use it, see usesPolarMap() (2 bytes a pixel,
+   72K on 192x192). The 'c' serial command frees it too when
+   starBurst leaves color mode 3.
+   With POLAR_IN_PSRAM it goes in the Teensy 4.1 PSRAM instead,
+   it's only read a row at a time so it's fine there.
+
+   Users: linesToOutside, starBurst color mode 3
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+// put the map in PSRAM, Teensy 4.1 with PSRAM fitted only
+//#define POLAR_IN_PSRAM
+
+
+struct PolarPixel {
+  uint8_t angle;
+  uint8_t radius;
+};
+
+
+
+class PolarMap {
+  public:
+
+    // builds the map if it isn't there for this screen size
+    bool begin()
+    {
+      if (_map != nullptr && _width == kScreenWidth + 1 && _height == kScreenHeight + 1)
+        return true;
+
+      release();
+      _width = kScreenWidth + 1;
+      _height = kScreenHeight + 1;
+
+      uint32_t bytes = (uint32_t)_width * _height * sizeof(PolarPixel);
+#ifdef POLAR_IN_PSRAM
+      _map = (PolarPixel*)extmem_malloc(bytes);
+#else
+      _map = (PolarPixel*)malloc(bytes);
+#endif
+      if (_map == nullptr)
+      {
+        Serial.println("polar map: out of memory");
+        return false;
+      }
+
+      build();
+      return true;
+    }
+
+
+    void release()
+    {
+      if (_map == nullptr)
+        return;
+
+#ifdef POLAR_IN_PSRAM
+      extmem_free(_map);
+#else
+      free(_map);
+#endif
+      _map = nullptr;
+    }
+
+
+    bool ready() { return _map != nullptr; }
+
+
+    // a row of the map, nullptr if it couldn't be built
+    const PolarPixel* row(uint16_t y)
+    {
+      if (!begin())
+        return nullptr;
+      return &_map[(uint32_t)y * _width];
+    }
+
+
+    // radius at x, y clamped onto the screen
+    uint8_t radius(int16_t x, int16_t y)
+    {
+      if (!begin())
+        return 0;
+
+      x = constrain(x, 0, _width - 1);
+      y = constrain(y, 0, _height - 1);
+      return _map[(uint32_t)y * _width + x].radius;
+    }
+
+
+    // pixels from the center to radius units. The scale comes
+    // from the map, so it's built first, 0 if it couldn't be
+    uint16_t radiusOf(float pixels)
+    {
+      if (!begin())
+        return 0;
+      return pixels * 255.0 / _maxDist;
+    }
+
+
+  private:
+    PolarPixel* _map = nullptr;
+    uint16_t _width = 0;
+    uint16_t _height = 0;
+    float _maxDist = 1.0;
+
+
+    void build()
+    {
+      uint32_t start = micros();
+
+      float cx = kMatrixCenterX;
+      float cy = kMatrixCenterY;
+      float farX = max(cx, _width - 1 - cx);
+      float farY = max(cy, _height - 1 - cy);
+      _maxDist = max(sqrtf(farX * farX + farY * farY), 1.0f);
+
+      for (uint16_t y = 0; y < _height; y++)
+      {
+        PolarPixel* row = &_map[(uint32_t)y * _width];
+        float dy = y - cy;
+
+        for (uint16_t x = 0; x < _width; x++)
+        {
+          float dx = x - cx;
+          float angle = atan2f(dy, dx);
+          if (angle < 0)
+            angle += TWO_PI;
+
+          row[x].angle = (uint16_t)(angle * 256.0 / TWO_PI + 0.5) & 0xFF;
+          float radius = sqrtf(dx * dx + dy * dy) * 255.0 / _maxDist + 0.5;
+          row[x].radius = (radius > 255) ? 255 : radius;
+        }
+      }
+
+      if (printLevel > 1)
+      {
+        Serial.print("polar map built in ");
+        Serial.print(micros() - start);
+        Serial.println(" uS");
+      }
+    }
+};
+
+
+
+PolarMap polar;
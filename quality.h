@@ -0,0 +1,122 @@
+/*************************************************************
+
+   quality.h - trades detail for frame rate on big displays
+
+   After each frame checkQuality() compares the drawing time
+   with the budget. A run of overruns steps quality down one
+   level, a long run of frames well inside the budget steps it
+   back up. Quality goes back to full on every pattern change.
+
+   Patterns ask for their knobs through qualityScale() (a count
+   between the full and lowest value) or qualityStep() (1 at
+   full quality, larger to skip pixels). Knobs in use:
+   starBurst   - number of stars
+   spiro       - max number of arms
+   plasma1/2   - noise calculated every 1, 2 or 4 pixels
+
+   'q' from serial prints the frame stats, 'Q' turns adaptive
+   quality on & off.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#define QUALITY_LEVELS          4         // 0 = lowest, 3 = full
+#define QUALITY_MIN_BUDGET      20000     // uS, budget is at least 50 fps
+#define QUALITY_DOWN_FRAMES     4         // overruns before stepping down
+#define QUALITY_UP_FRAMES       120       // good frames before stepping up
+
+
+// prototypes
+void checkQuality(uint32_t drawMicros, uint32_t period);
+void resetQuality();
+uint16_t qualityScale(uint16_t full, uint16_t lowest);
+uint8_t qualityStep();
+
+
+bool adaptiveQuality = true;
+uint8_t quality = QUALITY_LEVELS - 1;
+uint32_t qualityOverruns = 0;       // frames over budget since the last pattern change
+uint32_t qualityChanges = 0;        // times quality was stepped down
+uint16_t overCount = 0;
+uint16_t underCount = 0;
+
+
+
+
+void checkQuality(uint32_t drawMicros, uint32_t period)
+{
+  uint32_t budget = max(period, (uint32_t)QUALITY_MIN_BUDGET);
+
+  if (drawMicros > budget)
+  {
+    qualityOverruns++;
+    overCount++;
+    underCount = 0;
+  }
+  else if (drawMicros < budget * 3 / 4)
+  {
+    underCount++;
+    overCount = 0;
+  }
+
+  if (!adaptiveQuality)
+    return;
+
+  if (overCount >= QUALITY_DOWN_FRAMES && quality > 0)
+  {
+    quality--;
+    qualityChanges++;
+    overCount = 0;
+
+    if (printLevel > 1)
+    {
+      Serial.print("quality down "); Serial.println(quality);
+    }
+  }
+  else if (underCount >= QUALITY_UP_FRAMES && quality < QUALITY_LEVELS - 1)
+  {
+    quality++;
+    underCount = 0;
+
+    if (printLevel > 1)
+    {
+      Serial.print("quality up "); Serial.println(quality);
+    }
+  }
+}
+
+
+
+
+void resetQuality()
+{
+  quality = QUALITY_LEVELS - 1;
+  qualityOverruns = 0;
+  overCount = 0;
+  underCount = 0;
+}
+
+
+
+
+// full at the top level down to lowest at level 0
+uint16_t qualityScale(uint16_t full, uint16_t lowest)
+{
+  return lowest + (uint32_t)(full - lowest) * quality / (QUALITY_LEVELS - 1);
+}
+
+
+
+
+// pixel step for per pixel knobs, 1, 1, 2, 4
+uint8_t qualityStep()
+{
+  if (quality >= QUALITY_LEVELS - 2)
+    return 1;
+  return 1 << (QUALITY_LEVELS - 2 - quality);
+}
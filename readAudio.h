@@ -34,15 +34,51 @@
 #define MAX_AUDIO 1023
 //#define CAL_MODE
 
+// read the MSGEQ7 from a timer interrupt instead of busy-waiting
+#define USE_AUDIO_TIMER
+
+// allow playing a WAV file from the SD card as the audio source
+//#define USE_SD_AUDIO
+#define WAV_FILE_NAME "audio.wav"
+
+// integer audio math, for the Teensy 3.5/3.6 boards
+//#define USE_FIXED_AUDIO
+
+// software FFT spectrum from the line input instead of the MSGEQ7
+//#define USE_FFT_AUDIO
+
+
+// level & gain types. In fixed point the levels are whole
+// counts (0 - 1000) and the gain is Q16.16
+#ifdef USE_FIXED_AUDIO
+typedef int16_t audio_t;
+typedef int32_t gain_t;
+#define GAIN_SCALE  65536
+#else
+typedef float audio_t;
+typedef float gain_t;
+#define GAIN_SCALE  1
+#endif
+
 
 // prototypes
 void initAudio();
+void resetAudio();
 void readAudio();
 void getAudioData();
+void readMSGEQ7(uint16_t* bands);
 void adjustGain();
 void calcAvg();
 void findPeaks();
+#ifdef USE_FIXED_AUDIO
+int32_t scaleAudio(int32_t value);
+#else
+float scaleAudio(float value);
+#endif
 void interpolate();
+void scaleToScreen();
+void setAudioScreenHeight(uint16_t height);
+float gainValue();
 void printAudioValues();
 
 
@@ -51,13 +87,18 @@ void printAudioValues();
 // adjust these to your preference
 
 const bool useLogScale       = false;
-const float maxGain          = 16.0;
-const float minGain          = 0.1;
+const gain_t maxGain         = 16.0 * GAIN_SCALE;
+const gain_t minGain         = 0.1 * GAIN_SCALE;
+const gain_t gainUpStep      = 0.05 * GAIN_SCALE;
+const gain_t gainDownStep    = 0.20 * GAIN_SCALE;
 const uint16_t lowThreshold  = 450;
 const uint16_t highThreshold = 630;
-const int peakDecay          = 7;
-const float minThreashold    = 30;
-const float avgFactor        = 0.95;
+const uint16_t peakDecay     = 700;   // per second
+const audio_t minThreashold  = 30;
+const float avgFactor        = 0.95;  // per 10 mS (FRAME_REF_MICROS)
+#ifdef USE_FIXED_AUDIO
+const uint32_t avgFactorQ16  = avgFactor * 65536;
+#endif
 bool usePeaks                = true;
 
 // ----------------------------------------------
@@ -72,34 +113,62 @@ const uint8_t EQ_BANDS8 = 8;
 const uint8_t EQ_BANDS16 = 16;
 
 // global results from chip
-float rawAudio[EQ_BANDS7];      // audio levels for the 7 eq bands UNSCALED
-float audio[EQ_BANDS7];         // audio levels for the 7 eq bands scaled
-float peaks[EQ_BANDS7];         // peak audio values for each of the 7eq band
-float audio16[EQ_BANDS16];      // audio levels for the 16 interpolated bands
+audio_t rawAudio[EQ_BANDS7];    // audio levels for the 7 eq bands UNSCALED
+audio_t audio[EQ_BANDS7];       // audio levels for the 7 eq bands scaled
+audio_t peaks[EQ_BANDS7];       // peak audio values for each of the 7eq band
+audio_t audio16[EQ_BANDS16];    // audio levels for the 16 interpolated bands
 
 
 // global results (calculated)
-float   maxLevel = 0;           // max level in all 7 bands
+audio_t maxLevel = 0;           // max level in all 7 bands
 uint8_t maxBand = 0;            // band that the max level is in
-float   pkLevel = 0;            // max peak level in all 7 bands
+audio_t pkLevel = 0;            // max peak level in all 7 bands
 uint8_t pkBand = 0;             // band that the max peak level is in
-float   maxRaw = 0;             // max of the 7 raw audio level. No gain applied
-float   avgLevel = 0;           // avg audio level for all 7 bands
-float   avgBand = 0;            // running avg of maxBand
+audio_t maxRaw = 0;             // max of the 7 raw audio level. No gain applied
+audio_t avgLevel = 0;           // avg audio level for all 7 bands
+audio_t avgBand = 0;            // running avg of maxBand
+uint32_t audioTimestamp = 0;    // micros() when the current bands were captured
+
+
+// levels already scaled to the screen height, so patterns
+// don't need to divide (or use floats) per pixel column
+uint16_t audioHeight16[EQ_BANDS16];   // audio16[] in pixels
+uint16_t yAudioSF = 1;                // audio counts per pixel
+
+uint32_t peakDecayCarry = 0;          // part of a step left from the last frame
+
+
+#ifdef USE_FIXED_AUDIO
+// running averages kept with 8 fractional bits
+int32_t avgLevelQ8 = 0;
+int32_t avgBandQ8 = 0;
+#endif
 
 
 // adjusts how much gain is needed to keep display in range
 // when using linear scale (< 1.0 decreases gain). It is adjusted
 // dynamically based on input level. There are a couple of settings above
-float gain;
+gain_t gain;
 
 // values subtracted for each band to minimize background noise
 // should be tailored for each installation - see hardware.h
-float background[EQ_BANDS7] = BACKGROUND_OFFSET;
+audio_t background[EQ_BANDS7] = BACKGROUND_OFFSET;
 
 // enabled from serial to show audio data
 bool audioDebug = false;
 
+// enabled from serial to print raw bands for audioTrace.h
+bool recordAudio = false;
+
+
+#ifdef USE_AUDIO_TIMER
+#include "audioSampler.h"
+#endif
+
+#include "audioSource.h"
+#include "beatDetect.h"
+#include "bandMap.h"
+
 
 
 
@@ -113,17 +182,41 @@ void initAudio()
   digitalWrite(MSGEQ7_STROBE_PIN, HIGH);
   delay(500);
 
-  // starting gain
+  // starts the first source's sampler, the fft or the MSGEQ7
+  // timer, the others start when they're selected
+  selectAudioSource(0);
+
   if (useLogScale)
-  {
-    gain = 1.0;
     Serial.println("using Log Audio Scale");
-  }
   else
-  {
-    gain = 4.0;
     Serial.println("using Linear Audio Scale");
+
+  resetAudio();
+}
+
+
+
+// set starting gain and clear the level history
+void resetAudio()
+{
+  gain = (useLogScale ? 1.0 : 4.0) * GAIN_SCALE;
+
+  for (uint8_t band = 0; band < EQ_BANDS7; band++)
+  {
+    audio[band] = 0;
+    peaks[band] = 0;
   }
+
+  avgLevel = 0;
+  avgBand = 0;
+  peakDecayCarry = 0;
+
+#ifdef USE_FIXED_AUDIO
+  avgLevelQ8 = 0;
+  avgBandQ8 = 0;
+#endif
+
+  resetBeat();
 }
 
 
@@ -133,10 +226,17 @@ void initAudio()
 void readAudio()
 {
   getAudioData();
+#ifdef USE_FFT_AUDIO
+  if (fftActive())
+    scaleFftBands();
+#endif
   adjustGain();
   calcAvg();
   findPeaks();
   interpolate();
+  scaleToScreen();
+  updateBandMaps();
+  detectBeat();
 
   if (printLevel > 2)
     printAudioValues();
@@ -146,37 +246,117 @@ void readAudio()
 
 
 
-void getAudioData()
+// read the raw 10-bit values for all 7 EQ bands (0 - 6)
+void readMSGEQ7(uint16_t* bands)
 {
-  float value;
-
+#ifdef USE_AUDIO_TIMER
+  // latest set captured in the background
+  getSampledBands(bands, &audioTimestamp);
+#else
   // reset MSEG07 for data read, 100ns min
   digitalWrite(MSGEQ7_RESET_PIN, HIGH);
   delayMicroseconds(20);
   digitalWrite(MSGEQ7_RESET_PIN, LOW);
   delayMicroseconds(10);
 
-  maxLevel = 0;
-  maxRaw   = 0;
-  maxBand  = 0;
-
-  // read the MSGEQ7 value for all 7 EQ bands (0 - 6)
   for (uint8_t band = 0; band < EQ_BANDS7; band++)
   {
     digitalWrite(MSGEQ7_STROBE_PIN, LOW);
     delayMicroseconds(15);
 
     // read audio band votage
-    value = (float)analogRead(MSGEQ7_AUDIO_PIN);
+    bands[band] = analogRead(MSGEQ7_AUDIO_PIN);
+
+    // toggle msgeq7 to next band
+    digitalWrite(MSGEQ7_STROBE_PIN, HIGH);
+    delayMicroseconds(10);
+  }
+  audioTimestamp = micros();
+#endif
+}
+
+
+
+
+#ifdef USE_FIXED_AUDIO
+
+// 100 * ln(x) without floats. log2 from the bit position plus
+// a 16 entry table of log2(1 + i/16) for the fraction
+const uint16_t log2Table[17] = {
+  0, 22, 44, 63, 82, 100, 118, 134, 150, 165, 179, 193, 207, 220, 232, 244, 256
+};
+
+int32_t fixedLog100(int32_t x)
+{
+  if (x <= 1)
+    return 0;
+
+  uint8_t n = 31 - __builtin_clz(x);
+  uint32_t m = (uint32_t)x << (31 - n);
+  uint8_t index = (m >> 27) & 0x0F;
+  uint8_t frac = (m >> 19) & 0xFF;
+
+  int32_t log2Q8 = (n << 8) + log2Table[index] + (((log2Table[index + 1] - log2Table[index]) * frac) >> 8);
+
+  // 100 * ln(2) = 69.31, as Q16 / 256
+  return (log2Q8 * 17745) >> 16;
+}
+
+
+// apply the gain, value is 0 - MAX_AUDIO
+int32_t scaleAudio(int32_t value)
+{
+  if (useLogScale)
+    return fixedLog100((value * gain) >> 17);
+
+  return (value * gain) >> 16;
+}
+
+#else
+
+// apply the gain
+float scaleAudio(float value)
+{
+  if (useLogScale)
+    return logf(value * gain / 2) * 100.0;
 
-    if (simAudio)
+  return value * gain;
+}
+
+#endif
+
+
+
+
+void getAudioData()
+{
+#ifdef USE_FIXED_AUDIO
+  int32_t value;
+#else
+  float value;
+#endif
+  uint16_t bands[EQ_BANDS7];
+
+  currentAudioSource()->read(bands, &audioTimestamp);
+
+  if (recordAudio)
+  {
+    Serial.print("  {");
+    for (uint8_t band = 0; band < EQ_BANDS7; band++)
     {
-      // sim data for 8 seconds then 2 seconds of silence
-      if (millis() % 10000 < 2000)
-        value = 0;
-      else
-        value = (float)random(100, 700);
+      Serial.print(bands[band]);
+      Serial.print(band < EQ_BANDS7 - 1 ? ", " : "},\n");
     }
+  }
+
+  maxLevel = 0;
+  maxRaw   = 0;
+  maxBand  = 0;
+
+  // process all 7 EQ bands (0 - 6)
+  for (uint8_t band = 0; band < EQ_BANDS7; band++)
+  {
+    value = bands[band];
 
     // save raw value
     rawAudio[band] = value;
@@ -206,17 +386,8 @@ void getAudioData()
     }
     else
     {
-      // scale it
-      if (useLogScale)
-      {
-        if (value > 0)
-          value = log(value * gain / 2) * 100.0;
-      }
-      else
-      {
-        // linear scaling
-        value = value * gain;
-      }
+      // scale it, log or linear
+      value = scaleAudio(value);
 
       // bound it
       value = constrain(value, 0, 1000);
@@ -234,11 +405,6 @@ void getAudioData()
 
     if (audioDebug)
       printAudioValues();
-
-
-    // toggle msgeq7 to next band
-    digitalWrite(MSGEQ7_STROBE_PIN, HIGH);
-    delayMicroseconds(10);
   }
 }
 
@@ -247,37 +413,56 @@ void getAudioData()
 
 void adjustGain()
 {
-  // adjust audio gain based on max level detected
+  // adjust audio gain based on max level detected. Clamped so
+  // gain == maxGain reliably means no audio
   if (maxLevel < lowThreshold && gain < maxGain)
-    gain += 0.05;
+    gain = min(gain + gainUpStep, maxGain);
   else if (maxLevel > highThreshold && gain > minGain)
-    gain -= 0.20;
+    gain = max(gain - gainDownStep, minGain);
 }
 
 
 
 void calcAvg()
 {
+#ifdef USE_FIXED_AUDIO
+  int32_t sum = 0;
+  for (uint8_t band = 0; band < EQ_BANDS7; band++)
+    sum += audio[band];
+  int32_t newAvgQ8 = (sum << 8) / EQ_BANDS7;
+  int32_t avgFactorQ8 = frameDecayQ16(avgFactorQ16) >> 8;
+
+  avgLevelQ8 = (avgLevelQ8 * avgFactorQ8 + (256 - avgFactorQ8) * newAvgQ8) >> 8;
+  avgLevel = avgLevelQ8 >> 8;
+
+  avgBandQ8 = (avgBandQ8 * avgFactorQ8 + (256 - avgFactorQ8) * (maxBand << 8)) >> 8;
+  avgBand = avgBandQ8 >> 8;
+#else
   // first, std avg all 7 bands
   float sum = 0;
   for (uint8_t band = 0; band < EQ_BANDS7; band++)
     sum += audio[band];
   float newAvg = sum / (float)EQ_BANDS7;
-  
+  float factor = frameDecay(avgFactor);
+
   // then calc running average for level and and eq band
-  avgLevel = avgLevel * avgFactor + (1.0 - avgFactor) * newAvg;
+  avgLevel = avgLevel * factor + (1.0 - factor) * newAvg;
   //printValue("avgLevel", avgLevel);
 
-  avgBand = avgBand * avgFactor + (1.0 - avgFactor) * (float)maxBand;
+  avgBand = avgBand * factor + (1.0 - factor) * (float)maxBand;
   //printValue("avgBand", avgBand);
+#endif
 }
 
 
 void findPeaks()
 {
-  float value;
+  audio_t value;
   pkLevel = 0;
 
+  // same fall speed whatever the frame rate
+  audio_t decay = frameSteps(peakDecay, peakDecayCarry);
+
   //  check for peak for each hw band
   for (uint8_t band = 0; band < EQ_BANDS7; band++)
   {
@@ -295,11 +480,16 @@ void findPeaks()
       peaks[band] = value;
     else
     {
-      peaks[band] = peaks[band] - peakDecay;
+      peaks[band] = peaks[band] - decay;
       if (peaks[band] < 0)
         peaks[band] = 0;
     }
   }
+
+#ifdef USE_FFT_AUDIO
+  if (fftActive())
+    findFftPeaks(decay);
+#endif
 }
 
 
@@ -309,6 +499,22 @@ void findPeaks()
 // interpolate 7 bands into 16
 void interpolate()
 {
+#ifdef USE_FIXED_AUDIO
+  const audio_t* source = usePeaks ? peaks : audio;
+
+  for (int i = 0; i < EQ_BANDS16; i++)
+  {
+    // band position with 8 fractional bits
+    uint16_t pos = (i * ((EQ_BANDS7 - 1) << 8)) / (EQ_BANDS16 - 1);
+    uint8_t x = pos >> 8;
+    uint16_t v = pos & 0xFF;
+
+    if (i < EQ_BANDS16 - 1)
+      audio16[i] = ((256 - v) * source[x] + v * source[x + 1]) >> 8;
+    else
+      audio16[i] = source[x];
+  }
+#else
   float step = (1.0 * (EQ_BANDS7 - 1)) / (EQ_BANDS16 - 1);
   for (int i = 0; i < EQ_BANDS16; i++)
   {
@@ -331,6 +537,34 @@ void interpolate()
         audio16[i] = audio[x];
     }
   }
+#endif
+}
+
+
+
+
+// convert levels to pixel heights once per frame
+void scaleToScreen()
+{
+  for (uint8_t band = 0; band < EQ_BANDS16; band++)
+    audioHeight16[band] = audio16[band] / yAudioSF;
+}
+
+
+
+void setAudioScreenHeight(uint16_t height)
+{
+  yAudioSF = (MAX_AUDIO + 1) / (height + 1);
+  if (yAudioSF == 0)
+    yAudioSF = 1;
+}
+
+
+
+// gain as a plain number for printing
+float gainValue()
+{
+  return (float)gain / GAIN_SCALE;
 }
 
 
@@ -347,11 +581,16 @@ void printAudioValues()
       Serial.print("\t");
     }
     printValue();
-    printValue("gain", gain);
+    printValue("gain", gainValue());
     printValue("maxLevel", maxLevel);
     printValue("maxBand", maxBand);
     printValue("maxRaw", maxRaw);
     printValue("avgLevel", avgLevel);
+    printValue("audioAge", micros() - audioTimestamp);
+    printValue("bpm", bpm);
+#ifdef USE_FFT_AUDIO
+    printValue("fftMicros", fftMicros);
+#endif
     printValue();
   }
 }
@@ -0,0 +1,121 @@
+/*************************************************************
+
+   rings.h - buffer indexes of the points around each ring
+
+   The radial patterns walk rings of pixels, for every point
+   working out x = mapcos8(theta, ...), y = mapsin8(theta, ...)
+   and the buffer index. A RingTable does that once for all 256
+   angles of a ring and keeps the indexes, so walking a ring is
+   just reading ring(offset)[theta].
+
+   Ring offset goes from lo = offset to hi = (screen size - 1 -
+   inset) - offset, same as the patterns used:
+   streamRings - inset 1, CircleStream, radialTest and
+                 incrementalDrift
+   radialRings - inset 0, radialPixels
+
+   Rings are built the first time they're asked for (or all at
+   once by prepare() when the pattern starts) and kept while
+   the pattern runs (512 bytes each, 48K for all 95 stream rings
+   on 192x192). AudioPatterns::init() release()s the tables for
+   patterns that don't use them, like the symmetry table and the
+   polar map. They're built again if the screen size changes.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+#include "fastMath.h"
+
+
+#define RING_POINTS     256
+
+
+
+class RingTable {
+  public:
+    RingTable(uint8_t inset) : _inset(inset) {}
+
+
+    // the 256 buffer indexes of a ring, by theta
+    const uint16_t* ring(uint16_t offset)
+    {
+      if (_width != kScreenWidth || _height != kScreenHeight)
+        release();
+
+      if (offset >= _count)
+        build(offset + 1);
+
+      // out of memory, everything goes to pixel 0
+      if (offset >= _count)
+        return _none;
+
+      return &_table[(uint32_t)offset * RING_POINTS];
+    }
+
+
+    // build the first count rings now, from the pattern init
+    void prepare(uint16_t count)
+    {
+      if (count > 0)
+        ring(count - 1);
+    }
+
+
+    uint16_t count() { return _count; }
+
+
+    void release()
+    {
+      free(_table);
+      _table = nullptr;
+      _count = 0;
+      _width = kScreenWidth;
+      _height = kScreenHeight;
+    }
+
+
+  private:
+    uint16_t* _table = nullptr;
+    uint16_t _count = 0;            // rings built
+    uint16_t _width = 0;            // screen size they were built for
+    uint16_t _height = 0;
+    uint8_t _inset;
+    uint16_t _none[RING_POINTS] = {};
+
+
+    // grow the table to count rings, filling in the new ones
+    void build(uint16_t count)
+    {
+      uint16_t* table = (uint16_t*)realloc(_table, (uint32_t)count * RING_POINTS * sizeof(uint16_t));
+      if (table == nullptr)
+      {
+        Serial.println("ring table: out of memory");
+        return;
+      }
+      _table = table;
+
+      for (uint16_t offset = _count; offset < count; offset++)
+      {
+        uint16_t* ring = &_table[(uint32_t)offset * RING_POINTS];
+
+        for (uint16_t theta = 0; theta < RING_POINTS; theta++)
+        {
+          uint16_t x = mapcos8(theta, offset, (kScreenWidth - 1 - _inset) - offset);
+          uint16_t y = mapsin8(theta, offset, (kScreenHeight - 1 - _inset) - offset);
+          ring[theta] = (uint32_t)y * kMatrixWidth + x;
+        }
+      }
+
+      _count = count;
+    }
+};
+
+
+
+RingTable streamRings(1);
+RingTable radialRings(0);
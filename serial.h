@@ -16,6 +16,7 @@
 
 // prototypes
 void checkSerial();
+extern void printFrameStats();
 
 
 
@@ -41,6 +42,23 @@ void checkSerial()
       simAudio ? Serial.println("Enabled") : Serial.println("Disabled");
       break;
 
+    case 'A':
+      for (uint8_t i = 0; i < numAudioSources; i++)
+      {
+        if (audioSources[i] == audioSource)
+        {
+          selectAudioSource(i + 1);
+          break;
+        }
+      }
+      break;
+
+    case 'R':
+      recordAudio = !recordAudio;
+      Serial.print("recordAudio ");
+      recordAudio ? Serial.println("Enabled") : Serial.println("Disabled");
+      break;
+
     case 'd':
       printLevel++;
       if (printLevel > 3)
@@ -95,9 +113,17 @@ void checkSerial()
       colorMode++;
       if (colorMode > MAX_COLOR_MODES)
         colorMode = 0;
+      if (!audioPatterns.usesPolarMap())
+        polar.release();
       printValue("colorMode", colorMode);
       break;
 
+    case 'P':
+      palette.crossfade((palette.id() + 1) % NUM_PALETTES, 1000);
+      Serial.print("palette = ");
+      Serial.println(paletteName[palette.id()]);
+      break;
+
     case 'p':
       patternMode++;
       if (patternMode > MAX_PATTERN_MODES)
@@ -145,6 +171,26 @@ void checkSerial()
       showSettings();
       break;
 
+    case 'B':
+      runBenchmark();
+      break;
+
+    case 'b':
+      saveBenchBaseline();
+      break;
+
+    case 'q':
+      printFrameStats();
+      break;
+
+    case 'Q':
+      adaptiveQuality = !adaptiveQuality;
+      if (!adaptiveQuality)
+        resetQuality();
+      Serial.print("adaptive quality ");
+      adaptiveQuality ? Serial.println("Enabled") : Serial.println("Disabled");
+      break;
+
 
     case '?':
       Serial.println();
@@ -154,11 +200,18 @@ void checkSerial()
       Serial.println("0)  jump to pattern 0");
       Serial.println("1)  jump ahead 10 patterns");
       Serial.println("S)  show current Settings");
+      Serial.println("B)  run pattern Benchmark");
+      Serial.println("b)  save last benchmark as baseline");
+      Serial.println("q)  show frame time, overruns & quality");
+      Serial.println("Q)  toggle adaptive Quality");
       Serial.println("a)  toggle Audio sim mode");
+      Serial.println("A)  cycle Audio source (fft, msgeq7, sim, replay, wav)");
+      Serial.println("R)  toggle Recording raw bands for audioTrace.h");
       Serial.println("f)  Faster display");
       Serial.println("s)  Slower display");
       Serial.println("c)  starBurst: cycle Color mode");
       Serial.println("p)  starBurst: cycle Pattern");
+      Serial.println("P)  cycle color Palette (plasma, life, radial)");
       Serial.println("u)  toggle print Update rate");
       Serial.println("t)  toggle audio testMode (raw audio values)");
       Serial.println("T)  toggle audio debug values");
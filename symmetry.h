@@ -0,0 +1,259 @@
+/*************************************************************
+
+   symmetry.h - kaleidoscope symmetry for any screen size
+
+   build() works out, once per pattern change, where every
+   pixel of the screen takes its color from: a pixel in the
+   fundamental wedge (the part of the screen that repeats). The
+   pattern only draws the wedge and apply() then fills in the
+   rest of the screen from the table in one pass, top to bottom.
+
+   SYMMETRY_MIRROR2  - left half mirrored to the right
+   SYMMETRY_MIRROR4  - top left quarter mirrored to the others
+   SYMMETRY_MIRROR8  - as MIRROR4, and the quarter mirrored on
+                       its diagonal (the wedge is y <= x)
+   SYMMETRY_ROTATEn  - n copies of a pie slice rotated about the
+                       center, the slice starts at 3 o'clock and
+                       goes clockwise
+
+   symmetry.drawPixel() draws into the wedge wherever it's given,
+   so patterns can draw at any copy of a point. apply() also sets
+   the canvas tile bits (canvas.h) from the pixels it writes, so
+   they're exact after it whatever the pattern did before.
+
+   The table (2 bytes a pixel, 72K on 192x192) is allocated by
+   build() and freed when a pattern without symmetry is built,
+   like the polar map. If it can't be allocated the pattern runs
+   without symmetry.
+
+   vers 1.0  Oct2026
+
+ ************************************************/
+
+
+#pragma once
+
+
+enum {
+  SYMMETRY_NONE,
+  SYMMETRY_MIRROR2,
+  SYMMETRY_MIRROR4,
+  SYMMETRY_MIRROR8,
+  SYMMETRY_ROTATE3,
+  SYMMETRY_ROTATE4,
+  SYMMETRY_ROTATE6,
+  SYMMETRY_ROTATE8
+};
+
+
+// a pixel index has to fit in the table
+static_assert(kNumLEDs <= 65536, "symmetry table is 16 bits");
+
+
+
+class Symmetry {
+  public:
+
+    // rebuilds the table only if something changed
+    void build(uint16_t width, uint16_t height, uint8_t type)
+    {
+      if (type == _type && width == _width && height == _height)
+        return;
+
+      _type = type;
+      _width = width;
+      _height = height;
+
+      if (_type == SYMMETRY_NONE || !allocate())
+      {
+        release();
+        _type = SYMMETRY_NONE;
+        return;
+      }
+
+      uint32_t start = micros();
+
+      for (uint16_t y = 0; y < height; y++)
+      {
+        for (uint16_t x = 0; x < width; x++)
+        {
+          uint16_t sx = x;
+          uint16_t sy = y;
+
+          if (type >= SYMMETRY_ROTATE3)
+            rotateSource(sx, sy);
+          else
+            mirrorSource(sx, sy);
+
+          _table[(uint32_t)y * width + x] = (uint32_t)sy * width + sx;
+        }
+      }
+
+      // rounding can put a rotated source just outside the slice,
+      // follow it on to one that's inside, or keep the pixel
+      uint32_t count = (uint32_t)width * height;
+      for (uint32_t i = 0; i < count; i++)
+      {
+        uint16_t j = _table[i];
+        for (uint8_t n = 0; n < 4 && _table[j] != j; n++)
+          j = _table[j];
+        _table[i] = (_table[j] == j) ? j : i;
+      }
+
+      if (printLevel > 1)
+      {
+        Serial.print("symmetry built in ");
+        Serial.print(micros() - start);
+        Serial.println(" uS");
+      }
+    }
+
+
+    uint8_t type() { return _type; }
+
+
+    void release()
+    {
+      free(_table);
+      _table = nullptr;
+      _count = 0;
+    }
+
+
+    // copy the wedge to the rest of the screen
+    void apply()
+    {
+      if (_type == SYMMETRY_NONE)
+        return;
+
+      rgb24* pixels = fb.pixels();
+      uint8_t tileLit[MAX_TILE_ROWS] = {0};
+      uint32_t i = 0;
+
+      for (uint16_t y = 0; y < _height; y++)
+      {
+        for (uint16_t x = 0; x < _width; x++, i++)
+        {
+          rgb24 color = pixels[_table[i]];
+          pixels[i] = color;
+          tileLit[x >> TILE_SHIFT] |= color.red | color.green | color.blue;
+        }
+
+        // end of a row of tiles
+        if (((y + 1) & (TILE_SIZE - 1)) == 0 || y == _height - 1)
+        {
+          uint32_t bits = 0;
+          for (uint8_t tx = 0; tx < MAX_TILE_ROWS; tx++)
+          {
+            if (tileLit[tx])
+              bits |= 1UL << tx;
+            tileLit[tx] = 0;
+          }
+          canvas.setTileRowBits(y >> TILE_SHIFT, bits);
+        }
+      }
+    }
+
+
+    // draw at the copy of x, y that's in the wedge
+    void drawPixel(int16_t x, int16_t y, const rgb24& color)
+    {
+      if (_type == SYMMETRY_NONE)
+      {
+        canvas.drawPixel(x, y, color);
+        return;
+      }
+
+      if (x < 0 || x >= _width || y < 0 || y >= _height)
+        return;
+
+      canvas.setIndex(_table[(uint32_t)y * _width + x], color);
+    }
+
+
+  private:
+    uint16_t* _table = nullptr;
+    uint32_t _count = 0;                // pixels the table is allocated for
+    uint8_t _type = SYMMETRY_NONE;
+    uint16_t _width = 0;
+    uint16_t _height = 0;
+
+
+    // a table for _width x _height, kept if it's the right size
+    bool allocate()
+    {
+      uint32_t count = (uint32_t)_width * _height;
+      if (_table != nullptr && count == _count)
+        return true;
+
+      release();
+      _table = (uint16_t*)malloc(count * sizeof(uint16_t));
+      if (_table == nullptr)
+      {
+        Serial.println("symmetry table: out of memory");
+        return false;
+      }
+
+      _count = count;
+      return true;
+    }
+
+
+    void mirrorSource(uint16_t& x, uint16_t& y)
+    {
+      uint16_t halfWidth = (_width + 1) / 2;
+      uint16_t halfHeight = (_height + 1) / 2;
+
+      if (x >= halfWidth)
+        x = _width - 1 - x;
+
+      if (_type == SYMMETRY_MIRROR2)
+        return;
+
+      if (y >= halfHeight)
+        y = _height - 1 - y;
+
+      // below the diagonal, as long as the mirror image is on
+      // the screen (the quarter may not be square)
+      if (_type == SYMMETRY_MIRROR8 && y > x && y < halfWidth && x < halfHeight)
+      {
+        uint16_t t = x;
+        x = y;
+        y = t;
+      }
+    }
+
+
+    void rotateSource(uint16_t& x, uint16_t& y)
+    {
+      static const uint8_t folds[] = { 3, 4, 6, 8 };
+      float step = TWO_PI / folds[_type - SYMMETRY_ROTATE3];
+
+      float cx = (_width - 1) / 2.0;
+      float cy = (_height - 1) / 2.0;
+      float dx = x - cx;
+      float dy = y - cy;
+
+      float angle = atan2f(dy, dx);
+      if (angle < 0)
+        angle += TWO_PI;
+
+      // turn back into the first slice
+      float turn = -floorf(angle / step) * step;
+      float c = cosf(turn);
+      float s = sinf(turn);
+      float sx = dx * c - dy * s;
+      float sy = dx * s + dy * c;
+
+      // corners can turn off the screen, pull them in along the
+      // same line from the center so they stay in the slice
+      float t = 1.0;
+      if (fabsf(sx) > cx)
+        t = min(t, cx / fabsf(sx));
+      if (fabsf(sy) > cy)
+        t = min(t, cy / fabsf(sy));
+
+      x = constrain((int16_t)roundf(cx + sx * t), 0, _width - 1);
+      y = constrain((int16_t)roundf(cy + sy * t), 0, _height - 1);
+    }
+};